@@ -27,6 +27,7 @@ private:
     bool gameStarted;
     float loadingTimer;
     bool showDebugNodes;
+    double lastFrameClock;   // GetTime() at the previous Update (skipped frames do not refresh GetFrameTime)
 
     // Private helpers
     void Update();
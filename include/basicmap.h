@@ -2,14 +2,18 @@
 #define BASICMAP_H
 
 #include "roadgraph.h"
+#include "road_network.h"
 #include "raylib.h"
 #include "draw_utils.h"
-#include "city_structures.h"
+#include "mesh_builder.h"
+#include "city_buildings.h"
+#include <vector>
 
-// Gère le dessin de la partie visuelle (Basic Map)
-void DrawBasicMap();
+// Gère la partie visuelle (Basic Map)
+// Ground, roads, sidewalks, markings and roundabouts: static, added to 'mesh' once and baked
+// (see Simulation::Init), never redrawn piece by piece
+void BuildBasicMap(MeshBuilder& mesh);
+// Where the buildings of the map stand
+std::vector<BuildingPlacement> GetMapBuildings();
 
-// Gère l'initialisation de tous les nœuds et arcs (Logique)
-void InitializeRoadNetwork(RoadGraph& graph);
-
-#endif
\ No newline at end of file
+#endif
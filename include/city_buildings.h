@@ -0,0 +1,97 @@
+#ifndef CITY_BUILDINGS_H
+#define CITY_BUILDINGS_H
+
+#include "raylib.h"
+#include "mesh_builder.h"
+#include <cstdint>
+#include <vector>
+
+// Registry of the building types: one line per type.
+//   X(ID, Name, Builder)
+// Builder is the city_structures.h function adding the building to a MeshBuilder at
+// (position, rotation around +Y in degrees).
+#define BUILDING_TYPE_LIST(X) \
+    X(RESIDENTIAL_COMPLEX, "Residential complex", AddResidentialComplex)  \
+    X(HOUSE,               "House",               AddDetailedHouse)       \
+    X(CLINIC,              "Clinic",              AddDetailedClinic)      \
+    X(MOSQUE,              "Mosque",              AddDetailedMosque)      \
+    X(TOWNHOUSE,           "Townhouse",           AddDetailedTownhouse)   \
+    X(VILLA,               "Villa",               AddDetailedVilla)       \
+    X(BIG_STORE,           "Big store",           AddBigStore)            \
+    X(GAS_STATION,         "Gas station",         AddDetailedGasStation)  \
+    X(POLICE_STATION,      "Police station",      AddDetailedPoliceStation) \
+    X(BANK,                "Bank",                AddDetailedBank)        \
+    X(PLAYGROUND,          "Playground",          AddPlayground)          \
+    X(SCHOOL,              "School",              AddSchool)              \
+    X(PHARMACY,            "Pharmacy",            AddPharmacy)            \
+    X(BAKERY,              "Bakery",              AddBakery)              \
+    X(LAB,                 "Lab",                 AddLab)                 \
+    X(CAFE,                "Cafe",                AddCafe)                \
+    X(STADIUM,             "Stadium",             AddStadium)             \
+    X(CINEMA,              "Cinema",              AddCinema)              \
+    X(BURGER_SHOP,         "Burger shop",         AddBurgerShop)          \
+    X(FOUNTAIN,            "Fountain",            AddFountainAt)          \
+    X(GRAND_HOTEL,         "Grand hotel",         AddGrandHotel)
+
+enum BuildingType : uint8_t {
+#define X(ID, ...) BUILDING_##ID,
+    BUILDING_TYPE_LIST(X)
+#undef X
+    BUILDING_TYPE_COUNT
+};
+
+// One building of the map
+struct BuildingPlacement {
+    BuildingType type;
+    Vector3 position;
+    float rotation;   // Degrees around +Y
+};
+
+const char* GetBuildingTypeName(BuildingType type);
+
+// Adds a building to 'mesh' where the placement puts it (what the prototypes are made of)
+void AddBuilding(MeshBuilder& mesh, BuildingType type, Vector3 position, float rotation);
+
+// Prototype space -> world: turn around +Y, then move to the position (same as the
+// Translate / Rotate at the start of each Add* building function)
+Matrix GetPlacementTransform(const BuildingPlacement& placement);
+
+// The buildings of the map, drawn as instances: each type in use is built once at the origin
+// (its prototype, outlines included, baked into meshes) and every placement is only a transform.
+// A frame costs one instanced draw call per prototype mesh instead of re-sending the hundreds of
+// cubes and lines of every building. Load / Unload need the window (GL context).
+class CityBuildings {
+private:
+    BakedGeometry prototypes[BUILDING_TYPE_COUNT];
+    std::vector<Matrix> transforms[BUILDING_TYPE_COUNT];   // One per placement of the type
+    std::vector<BoundingBox> placedBounds[BUILDING_TYPE_COUNT];   // World box of each placement
+    std::vector<Matrix> visible;   // Scratch of Draw: the placements of one type in view
+    Material instancing = {};      // Vertex colors, model matrix per instance
+    bool instanced = false;        // Shader available (else one DrawMesh per placement)
+    bool loaded = false;
+    int triangleCount = 0;         // In the prototypes (outline quads included)
+    int placedTriangleCount = 0;   // Drawn per frame, all placements
+    int outlineCount = 0;          // Outline segments in the prototypes
+    int drawnCount = 0;
+
+public:
+    CityBuildings() {}
+    ~CityBuildings() { Unload(); }
+    CityBuildings(const CityBuildings&) = delete;
+    CityBuildings& operator=(const CityBuildings&) = delete;
+
+    void Load(const std::vector<BuildingPlacement>& placements);
+    void Unload();
+    // Placements whose box is out of 'view' are not sent
+    void Draw(const Frustum& view = Frustum());
+
+    bool IsInstanced() const { return instanced; }
+    int GetPrototypeCount() const;
+    int GetInstanceCount() const;
+    int GetTriangleCount() const { return triangleCount; }
+    int GetPlacedTriangleCount() const { return placedTriangleCount; }
+    int GetOutlineCount() const { return outlineCount; }
+    int GetDrawnCount() const { return drawnCount; }   // Placements sent by the last Draw
+};
+
+#endif
@@ -4,10 +4,11 @@
 #include "raylib.h"
 #include <string>
 #include <vector>
+#include "vehicle_types.h"
 
-// Structure for a specific type of vehicle (e.g., "Car", 10 cars, start nodes...)
+// Structure for a specific type of vehicle (e.g., Car, 10 cars, start nodes...)
 struct VehicleSpawnConfig {
-    std::string type;
+    VehicleType type;
     int count;          // This will be editable in the menu
     std::vector<int> startNodes;
 };
@@ -16,22 +17,38 @@ struct VehicleSpawnConfig {
 struct SimulationConfig {
     int maxVehicles = 50;
     float simulationSpeed = 1.0f; // 1.0x = Normal, 2.0x = Fast
+    int turboMultiplier = 0;      // Turbo fast-forward (10x..1000x), replaces the slider speed; 0 = off
+    unsigned int seed = 12345;    // Spawn placement and turn choices (same seed -> same run)
+    float tickRate = 60.0f;       // Fixed simulation ticks per second of sim time
+    int threadCount = 0;          // Threads for the vehicle update (1 = serial, 0 = one per hardware thread)
+    bool routing = true;          // Vehicles follow planned routes to an exit (false = random turns)
+    float rerouteInterval = 2.0f; // Sim seconds between route refreshes from the travel times (0 = planned once)
     
     // List of all vehicle groups
     std::vector<VehicleSpawnConfig> vehicleConfigs;
     
+    // Speed factor actually applied to the sim clock
+    float GetEffectiveSpeed() const { return turboMultiplier > 0 ? (float)turboMultiplier : simulationSpeed; }
+    
     // Constants (Screen size, etc.)
     static const int SCREEN_WIDTH = 1280;
     static const int SCREEN_HEIGHT = 720;
+
+    // Upper bound for the "Max Limit" setting (neighbour search is grid based, see SpatialGrid)
+    static const int MAX_VEHICLE_LIMIT = 10000;
+
+    // Vehicles per chunk of the parallel vehicle update
+    static const int VEHICLE_BATCH = 256;
+
+    // Longest frame fed to the fixed-step loop: a hitch (window drag, loading) is dropped, not simulated
+    static constexpr float MAX_FRAME_TIME = 0.25f;
     
-    // Vehicle Speeds
-    static constexpr float CAR_SPEED = 15.0f;
-    static constexpr float BUS_SPEED = 10.0f;
-    static constexpr float TRUCK_SPEED = 8.0f;
-    static constexpr float TAXI_SPEED = 18.0f;
-    static constexpr float POLICE_SPEED = 22.0f;
-    static constexpr float MOTORCYCLE_SPEED = 20.0f;
+    // Vehicle speeds and lengths: see VEHICLE_TYPE_LIST (vehicle_types.h)
     static constexpr float ARRIVAL_THRESHOLD = 2.0f;
+    // Speed giving the travel time of an edge nobody has driven yet (routing)
+    static constexpr float FREE_FLOW_SPEED = 12.0f;
+    // An entry point (spawn / teleport landing) is blocked while a vehicle is this close to it
+    static constexpr float NODE_CLEAR_RADIUS = 8.0f;
 };
 
 // Global config instance (declared here, defined in cpp)
@@ -40,8 +57,12 @@ extern SimulationConfig globalConfig;
 // Function to reset/load defaults
 SimulationConfig GetDefaultConfig();
 
-// Cet alias permet d'utiliser "CONFIG::CAR_SPEED" dans votre code
-// au lieu de devoir écrire "SimulationConfig::CAR_SPEED"
+// Turbo steps: off, 10x, 30x, 100x, 300x, 1000x. Returns the level after 'current' in
+// 'direction' (+1 / -1), clamped at both ends.
+int NextTurboLevel(int current, int direction);
+
+// Cet alias permet d'utiliser "CONFIG::ARRIVAL_THRESHOLD" dans votre code
+// au lieu de devoir écrire "SimulationConfig::ARRIVAL_THRESHOLD"
 using CONFIG = SimulationConfig;
 
 #endif
\ No newline at end of file
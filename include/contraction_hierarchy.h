@@ -0,0 +1,85 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <iosfwd>
+#include <cstdint>
+#include "roadgraph.h"
+
+// Contraction hierarchy over a finalized RoadGraph, for point-to-point queries on large maps.
+// Build contracts the nodes one by one (least important first) and adds a shortcut u -> w
+// for every shortest path u -> v -> w that would disappear with v. A query is then two
+// small Dijkstra searches that only go up the hierarchy, one from each end.
+// Same rules as RoutePlanner: cost = one value per dense edge, a path never goes through a
+// TELEPORT node (it can only end on one), so the edges leaving a TELEPORT node are ignored.
+// Saved once per map (Save / Load): the build is the slow part.
+class ContractionHierarchy {
+public:
+    struct Edge {
+        int to;        // Higher ranked node (dense index)
+        float cost;
+        int middle;    // Contracted node of a shortcut, -1 for a graph edge
+    };
+
+private:
+    int nodeCount = 0;
+    int graphEdgeCount = 0;          // Of the RoadGraph it was built for (checked by Load)
+    std::vector<int> rank;           // Contraction order, 0 = contracted first
+    // Upward edges, CSR by node: up[upOffsets[v] .. upOffsets[v + 1]) leave v,
+    // down[downOffsets[v] .. downOffsets[v + 1]) enter v (Edge::to is then the source)
+    std::vector<int> upOffsets;
+    std::vector<Edge> up;
+    std::vector<int> downOffsets;
+    std::vector<Edge> down;
+
+    // Graph edge or shortcut from -> to, replaced by the nodes between them
+    void Unpack(int from, int to, int middle, std::vector<int>& path) const;
+    const Edge* FindUp(int from, int to) const;
+    const Edge* FindDown(int to, int from) const;
+
+    friend class ChQuery;
+
+public:
+    // costs: one per dense edge of 'graph' (RoutePlanner::GetEdgeCosts), >= 0
+    void Build(const RoadGraph& graph, const std::vector<float>& costs);
+    bool IsBuilt() const { return nodeCount > 0; }
+
+    int GetNodeCount() const { return nodeCount; }
+    int GetRank(int node) const { return rank[node]; }
+    // Graph edges + shortcuts
+    size_t GetEdgeCount() const { return up.size() + down.size(); }
+    size_t GetShortcutCount() const;
+
+    // Binary, native byte order. Load throws std::runtime_error on a bad file or one built
+    // for another graph (node / edge counts differ).
+    void Save(std::ostream& out) const;
+    void Load(std::istream& in, const RoadGraph& graph);
+};
+
+// Query state over one hierarchy (the hierarchy itself is read only: one ChQuery per thread).
+// Scratch arrays are stamped per query, so a query costs what it visits, not the map size.
+class ChQuery {
+private:
+    const ContractionHierarchy* ch;
+    struct Label {
+        float cost;
+        int parent;      // Previous node of the search, -1 at its root
+        int middle;      // Middle of the edge parent -> node (-1 = graph edge)
+        uint32_t stamp;  // Query that wrote the label
+    };
+    std::vector<Label> forward;
+    std::vector<Label> backward;
+    uint32_t stamp = 0;
+    int settledCount = 0;
+
+public:
+    explicit ChQuery(const ContractionHierarchy& hierarchy);
+
+    // Cheapest route origin -> destination (dense indices); false (and 'path' empty) if unreachable.
+    // 'path' is optional: without it only the cost is computed.
+    bool FindRoute(int origin, int destination, float* cost, std::vector<int>* path = nullptr);
+    // Nodes settled by the last query (both directions)
+    int GetSettledCount() const { return settledCount; }
+};
+
+#endif
@@ -2,17 +2,18 @@
 #define DRAW_UTILS_H
 
 #include "raylib.h"
-#include "rlgl.h" 
+#include "mesh_builder.h"
 #include <vector>
 #include <cmath>
 
-void DrawArcSegment(Vector3 center, float innerRadius, float width, float startAngle, float endAngle, Color color);
-void DrawSidewalkBlockArc(Vector3 center, float innerRadius, float width, float height, float startAngle, float endAngle, Color color);
-void DrawRoundedRoadArc(Vector3 center, float innerRadius, float width, float height, float startAngle, float endAngle, Color color);
-void DrawRoadLineArc(Vector3 center, float innerRadius, float width, float height, float startAngle, float endAngle, Color color);
-void DrawRingFlat(Vector3 center, float innerRadius, float outerRadius, Color color);
-void DrawZebraCrossing(Vector3 center, float roadWidth, float stripeLength, float angle);
-void DrawTerminalRoundabout(Vector3 center);
-void DrawSidewalkSegment(Vector3 pos, float lenX, float lenZ);
+// Map pieces, added to a MeshBuilder (baked once, see BuildBasicMap) instead of drawn every frame
+void AddArcSegment(MeshBuilder& mesh, Vector3 center, float innerRadius, float width, float startAngle, float endAngle, Color color);
+void AddSidewalkBlockArc(MeshBuilder& mesh, Vector3 center, float innerRadius, float width, float height, float startAngle, float endAngle, Color color);
+void AddRoundedRoadArc(MeshBuilder& mesh, Vector3 center, float innerRadius, float width, float height, float startAngle, float endAngle, Color color);
+void AddRoadLineArc(MeshBuilder& mesh, Vector3 center, float innerRadius, float width, float height, float startAngle, float endAngle, Color color);
+void AddRingFlat(MeshBuilder& mesh, Vector3 center, float innerRadius, float outerRadius, Color color);
+void AddZebraCrossing(MeshBuilder& mesh, Vector3 center, float roadWidth, float stripeLength, float angle);
+void AddTerminalRoundabout(MeshBuilder& mesh, Vector3 center);
+void AddSidewalkSegment(MeshBuilder& mesh, Vector3 pos, float lenX, float lenZ);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,53 @@
+#ifndef EVENT_SCHEDULER_H
+#define EVENT_SCHEDULER_H
+
+#include <vector>
+#include <functional>
+#include <unordered_set>
+
+typedef unsigned long long EventId;
+
+// Simulation clock + priority queue of future events.
+// Components register a callback for a sim time and cost nothing until it fires,
+// instead of decrementing a timer every frame.
+class EventScheduler {
+private:
+    struct Event {
+        double time;
+        EventId id;    // Also the insertion order: ties fire first-scheduled first
+        std::function<void()> callback;
+    };
+    // Min-heap on (time, id)
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            if (a.time != b.time) return a.time > b.time;
+            return a.id > b.id;
+        }
+    };
+
+    double now;
+    EventId nextId;
+    std::vector<Event> heap;
+    std::unordered_set<EventId> cancelled; // Lazily dropped when they reach the top
+
+public:
+    EventScheduler();
+
+    double Now() const { return now; }
+
+    // Callbacks may schedule or cancel other events (including re-scheduling themselves)
+    EventId Schedule(double delay, std::function<void()> callback);
+    EventId ScheduleAt(double time, std::function<void()> callback);
+    void Cancel(EventId id);
+
+    // Moves the clock forward and fires every event that is due, in time order.
+    // While a callback runs, Now() is the event time, so periodic events do not drift.
+    void Advance(double dt);
+
+    // Drops all events and resets the clock to 0
+    void Clear();
+
+    int GetPendingCount() const { return (int)(heap.size() - cancelled.size()); }
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "raylib.h"
+
+// View volume of a Camera3D as 6 planes, for culling what is drawn against bounding volumes.
+// Built once per frame (Simulation::Draw3D) and shared by every Draw of that frame, the 2D
+// labels included. Tests are conservative: "intersects" may be true for a volume just outside
+// a corner, never false for a visible one.
+class Frustum {
+private:
+    // Plane (x, y, z) . p + w: >= 0 inside, normals pointing in, unit length
+    Vector4 planes[6];
+    Vector3 eye = { 0.0f, 0.0f, 0.0f };   // Camera position (level of detail distances)
+    bool enabled = false;   // Default: everything visible
+
+public:
+    // Near / far as BeginMode3D (rlgl RL_CULL_DISTANCE_NEAR / FAR)
+    static constexpr float NEAR_PLANE = 0.01f;
+    static constexpr float FAR_PLANE = 1000.0f;
+
+    Frustum() {}
+    // 'aspect': width / height of the target the camera renders to
+    static Frustum FromCamera(const Camera3D& camera, float aspect, float nearPlane = NEAR_PLANE, float farPlane = FAR_PLANE);
+
+    bool IsEnabled() const { return enabled; }
+    Vector3 GetEye() const { return eye; }
+    bool ContainsPoint(Vector3 point) const;
+    bool IntersectsSphere(Vector3 center, float radius) const;
+    bool IntersectsBox(const BoundingBox& box) const;
+};
+
+// Box around 'box' once moved by 'transform' (corners transformed, then enclosed)
+BoundingBox TransformBox(const BoundingBox& box, const Matrix& transform);
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstddef>
+
+typedef int TaskId;
+
+// Accumulated timing of one task (all its chunks), see JobSystem::SetProfiling
+struct TaskProfile {
+    std::string name;
+    long long runs = 0;       // Graph runs in which the task did some work
+    long long chunks = 0;
+    double busyTime = 0.0;    // Wall seconds spent in the task, summed over threads
+};
+
+// Small work-stealing job system.
+// A graph of tasks is declared once (AddTask / AddParallelTask / AddDependency) and run as
+// many times as needed (Run). A parallel task reads its item count when it becomes ready and
+// is cut into chunks of 'grain' items, so per-vehicle work spreads over the threads while
+// independent tasks overlap. Each thread owns a deque: it pops its newest work, idle threads
+// steal the oldest work of the others. The calling thread of Run takes part as thread 0.
+//
+// Tasks must only share data through their dependencies; when a parallel task only writes
+// the items of its own chunks, the results do not depend on the thread count.
+class JobSystem {
+private:
+    struct Task {
+        std::string name;
+        std::function<void()> run;                      // Plain task
+        std::function<size_t()> count;                 // Parallel task: items this run
+        std::function<void(size_t, size_t)> runRange;   // Parallel task: one chunk
+        size_t grain = 1;
+        std::vector<TaskId> successors;
+        int predecessorCount = 0;
+
+        // Per run
+        std::atomic<int> waitingFor;
+        std::atomic<size_t> chunksLeft;
+        Task() : waitingFor(0), chunksLeft(0) {}
+    };
+
+    // A whole task (begin == end == NO_RANGE) or one chunk of a parallel task
+    struct WorkItem {
+        TaskId task;
+        size_t begin;
+        size_t end;
+    };
+    static const size_t NO_RANGE = (size_t)-1;
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<WorkItem> items;
+        // Profiling (only written by the owner thread)
+        std::vector<double> taskTime;
+        std::vector<long long> taskChunks;
+        std::vector<unsigned char> taskRan;
+        double busyTime = 0.0;
+    };
+
+    std::vector<std::unique_ptr<Task>> tasks;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;   // queues[0] = calling thread
+    std::vector<std::thread> threads;
+
+    // Run state
+    std::atomic<int> tasksLeft;
+    std::mutex runMutex;
+    std::condition_variable wake;
+    unsigned long long generation = 0;
+    bool stopping = false;
+
+    // Threads out of work during a run (waiting on a dependency) park here after a few yields
+    std::mutex idleMutex;
+    std::condition_variable idleWake;
+    std::atomic<int> sleepers;
+    unsigned long long workEpoch = 0;   // Bumped under idleMutex when work is pushed or the run ends
+
+    // Profiling
+    bool profiling = false;
+    std::vector<TaskProfile> profile;
+    std::vector<double> threadBusy;
+    double runTime = 0.0;
+
+    void WorkerLoop(int index);
+    void Participate(int index);
+    bool PopOrSteal(int index, WorkItem& item);
+    void Push(int index, const WorkItem& item);
+    void Park(int index);
+    void WakeIdle();
+    void Execute(int index, const WorkItem& item);
+    void Finish(int index, TaskId id);
+    void StartThreads(int count);
+    void StopThreads();
+    void CollectProfile();
+
+public:
+    // 'threadCount' counts the calling thread (1 = everything inline, 0 = one per hardware thread)
+    explicit JobSystem(int threadCount = 1);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void SetThreadCount(int threadCount);
+    int GetThreadCount() const { return (int)queues.size(); }
+
+    // --- Graph (kept between runs) ---
+    TaskId AddTask(const std::string& name, std::function<void()> run);
+    TaskId AddParallelTask(const std::string& name, std::function<size_t()> count, size_t grain,
+                           std::function<void(size_t, size_t)> runRange);
+    // 'after' starts once 'before' is done
+    void AddDependency(TaskId before, TaskId after);
+    void ClearTasks();
+
+    // Runs every task of the graph once, returns when all of them are done
+    void Run();
+
+    // One-off data-parallel loop outside the graph: body(begin, end) over chunks of [0, count)
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    // --- Per-task timing (off by default: two clock reads per chunk) ---
+    void SetProfiling(bool enabled);
+    void ResetProfile();
+    const std::vector<TaskProfile>& GetProfile() const { return profile; }
+    // Busy wall time of each thread during the runs, and the wall time of the runs:
+    // runTime - busy = time the thread sat idle (waiting on dependencies or out of work)
+    const std::vector<double>& GetThreadBusyTime() const { return threadBusy; }
+    double GetRunTime() const { return runTime; }
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef KINEMATICS_KERNEL_H
+#define KINEMATICS_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Batched vehicle kinematics over the SoA arrays: speed control (car following, acceleration /
+// braking clamp) and steering + position integration. 8 vehicles per instruction with AVX2,
+// 4 with SSE2, picked once at run time; the scalar functions are the reference.
+// The batched code does the same IEEE operations in the same order (no approximations),
+// so it matches the scalar path to the last bit in practice.
+
+enum KinematicsLevel { KINEMATICS_SCALAR = 0, KINEMATICS_SSE2 = 1, KINEMATICS_AVX2 = 2 };
+
+// What decides the target speed of a vehicle this tick (int32 for the vector compares)
+enum SpeedMode : int32_t {
+    SPEED_CONTROL = 0,   // Desired speed, reduced when following (gap)
+    SPEED_STOP = 1,      // Red light / crossing traffic: target 0
+    SPEED_FORCED = 2,    // Clicked vehicle: forced speed, no obstacle
+    SPEED_FROZEN = 3     // Finished: speed kept as is
+};
+
+// No leader: the gap is far beyond any slowing distance
+static const float NO_LEADER_GAP = 1.0e30f;
+
+struct SpeedControlParams {
+    float minSafeDist;
+    float startSlowingDist;
+    float forcedSpeed;
+    float dt;
+};
+
+// Per-vehicle inputs (all arrays start at the first vehicle of the batch)
+struct SpeedControlInput {
+    const float* speed;
+    const float* desiredSpeed;
+    const float* gap;            // Bumper gap to the leader, NO_LEADER_GAP if none
+    const float* leaderSpeed;
+    const int32_t* mode;         // SpeedMode
+};
+
+// Steering toward the target node and position integration.
+// Vehicles within the arrival threshold (or that would pass the node this step) are not moved:
+// 'arrived' is set and the scalar arrival logic takes over (Vehicle::Arrive).
+struct SteeringArrays {
+    float* posX;
+    const float* posY;
+    float* posZ;
+    float* fwdX;
+    float* fwdZ;
+    const float* speed;
+    const float* targetX;
+    const float* targetY;
+    const float* targetZ;
+    const int32_t* active;       // 0 = skip (finished vehicle)
+    unsigned char* arrived;      // Out: 1 = arrival logic needed
+};
+
+void SpeedControlScalar(const SpeedControlInput& in, float* outSpeed, size_t count, const SpeedControlParams& p);
+void SpeedControlBatch(const SpeedControlInput& in, float* outSpeed, size_t count, const SpeedControlParams& p);
+
+void SteerScalar(const SteeringArrays& a, size_t count, float dt, float arrivalThreshold);
+void SteerBatch(const SteeringArrays& a, size_t count, float dt, float arrivalThreshold);
+
+// Best level the CPU supports, and the one used by the Batch functions (tests can lower it)
+KinematicsLevel GetBestKinematicsLevel();
+KinematicsLevel GetKinematicsLevel();
+void SetKinematicsLevel(KinematicsLevel level);   // Clamped to the best supported level
+const char* GetKinematicsLevelName(KinematicsLevel level);
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef MESH_BUILDER_H
+#define MESH_BUILDER_H
+
+#include "raylib.h"
+#include "frustum.h"
+#include <cstddef>
+#include <vector>
+
+// Collects static geometry on the CPU (triangles with a color per vertex, plus outline
+// segments), so that a whole scene part becomes a few meshes uploaded once instead of
+// thousands of immediate-mode calls per frame.
+// The Add* shapes take the arguments of the raylib Draw* function of the same name, and
+// PushMatrix / Translate / Rotate work like the rlgl matrix stack: drawing code moves over
+// by replacing DrawCube(...) with mesh.AddCube(...).
+// The scene is only seen from above the ground: faces looking down from y <= 0 and faces
+// without area (a cube of zero height is its top face) are left out.
+class MeshBuilder {
+private:
+    std::vector<Vector3> positions;   // 3 per triangle, counter-clockwise seen from outside
+    std::vector<Vector3> normals;
+    std::vector<Color> colors;
+    std::vector<Vector3> linePoints;  // 2 per segment
+    std::vector<Color> lineColors;
+    Matrix transform;                 // Applied to everything added
+    std::vector<Matrix> stack;
+
+public:
+    MeshBuilder();
+
+    // --- Transform (rlPushMatrix, rlPopMatrix, rlTranslatef, rlRotatef) ---
+    void PushMatrix();
+    void PopMatrix();
+    void Translate(float x, float y, float z);
+    void Rotate(float angle, float x, float y, float z);   // Degrees around (x, y, z)
+
+    // Triangle / quad facing 'normal' (the winding is fixed up if the corners come the other way)
+    void AddTriangle(Vector3 a, Vector3 b, Vector3 c, Vector3 normal, Color color);
+    void AddQuad(Vector3 a, Vector3 b, Vector3 c, Vector3 d, Vector3 normal, Color color);
+    void AddLine(Vector3 a, Vector3 b, Color color);   // DrawLine3D
+
+    // --- raylib shapes ---
+    void AddCube(Vector3 position, float width, float height, float length, Color color);
+    void AddCubeWires(Vector3 position, float width, float height, float length, Color color);
+    void AddPlane(Vector3 center, Vector2 size, Color color);
+    void AddCylinder(Vector3 position, float radiusTop, float radiusBottom, float height, int slices, Color color);
+    void AddCylinderWires(Vector3 position, float radiusTop, float radiusBottom, float height, int slices, Color color);
+    void AddCylinderEx(Vector3 startPos, Vector3 endPos, float startRadius, float endRadius, int sides, Color color);
+    void AddSphere(Vector3 center, float radius, Color color);
+    // Flat ring in the XZ plane, facing up; angles in degrees from +X towards +Z
+    void AddRing(Vector3 center, float innerRadius, float outerRadius, float startAngle, float endAngle, int segments, Color color);
+
+    void Clear();
+    int GetTriangleCount() const { return (int)positions.size() / 3; }
+    int GetLineCount() const { return (int)linePoints.size() / 2; }
+
+    friend class BakedGeometry;
+};
+
+// GPU side of a MeshBuilder: the triangles in as few meshes as possible (one draw call each),
+// drawn with vertex colors, unlit. The outlines are baked into the same meshes as thin quads.
+// With a tile size, the triangles are first sorted into square XZ tiles with their own bounds,
+// so that a Draw against a Frustum skips the tiles out of view.
+// Load / Unload need the window (GL context).
+class BakedGeometry {
+private:
+    std::vector<Mesh> meshes;
+    std::vector<BoundingBox> meshBounds;
+    Material material = {};
+    BoundingBox bounds = {};           // Everything
+    bool loaded = false;
+
+public:
+    // Vertices per mesh (keeps each vertex buffer a reasonable size)
+    static const int MAX_MESH_VERTICES = 3 * 20000;
+
+    BakedGeometry() {}
+    ~BakedGeometry() { Unload(); }
+    BakedGeometry(const BakedGeometry&) = delete;
+    BakedGeometry& operator=(const BakedGeometry&) = delete;
+
+    // 'tileSize' <= 0: no tiles (one bound for everything)
+    void Load(const MeshBuilder& builder, float tileSize = 0.0f);
+    void Unload();
+    bool IsLoaded() const { return loaded; }
+
+    // The meshes whose tile is in 'view'
+    void Draw(const Frustum& view = Frustum()) const;
+    // Once per transform: one instanced draw call per mesh with a material whose
+    // shader reads the instance transforms (see CityBuildings), one DrawMesh per copy otherwise
+    void DrawInstanced(const std::vector<Matrix>& transforms, const Material& instancing, bool instanced) const;
+
+    const BoundingBox& GetBounds() const { return bounds; }
+    int GetMeshCount() const { return (int)meshes.size(); }
+    int GetTriangleCount() const;
+};
+
+#endif
@@ -2,12 +2,12 @@
 #define MODEL_MANAGER_H
 
 #include "raylib.h"
-#include <map>
-#include <string>
+#include "vehicle_types.h"
 
 class ModelManager {
 private:
-    std::map<std::string, Model> models;
+    Model models[VEHICLE_TYPE_COUNT] = {};   // Indexed by type
+    bool loaded = false;
     
 public:
     ModelManager();
@@ -17,7 +17,8 @@ public:
     void LoadModels();
     
     // Get a specific model by type
-    Model& GetModel(const std::string& type);
+    Model& GetModel(VehicleType type) { return models[type]; }
+    const Model& GetModel(VehicleType type) const { return models[type]; }
     
     // Cleanup
     void UnloadModels();
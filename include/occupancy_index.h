@@ -0,0 +1,47 @@
+#ifndef OCCUPANCY_INDEX_H
+#define OCCUPANCY_INDEX_H
+
+#include "raylib.h"
+#include <vector>
+#include <memory>
+#include "config.h"
+#include "roadgraph.h"
+#include "spatial_grid.h"
+
+class VehiclePool;
+
+// Number of vehicles around the entry points of the network (START nodes and teleport
+// landings), so "is this entry point clear?" is one array lookup instead of a scan of all vehicles.
+class OccupancyIndex {
+private:
+    float radius;
+    std::vector<int> zoneOfNode;     // Dense node index -> zone (-1 = not watched)
+    std::vector<Vector3> zoneCenters;
+    std::vector<int> counts;         // Vehicles inside each zone
+    SpatialGrid zoneGrid;            // Static: built once from the zone centers
+
+    void AddZone(const RoadGraph& graph, int nodeIndex);
+
+public:
+    OccupancyIndex(float radius = CONFIG::NODE_CLEAR_RADIUS);
+
+    // Picks the watched nodes of a finalized graph (call again when the graph is rebuilt).
+    // 'extraNodeIds' adds entry points that are not START nodes (e.g. custom spawn nodes).
+    void Watch(const RoadGraph& graph, const std::vector<int>& extraNodeIds = std::vector<int>());
+
+    // Recounts the zones from the current vehicle positions (once per tick)
+    void Update(const VehiclePool& vehicles);
+
+    // A vehicle was just placed on 'nodeIndex' (spawn or teleport): the zone stays busy until the next Update
+    void MarkArrival(int nodeIndex);
+
+    // True if no vehicle is within 'radius' of the node. Nodes that are not watched are always clear.
+    bool IsClear(int nodeIndex) const {
+        int zone = zoneOfNode[nodeIndex];
+        return zone < 0 || counts[zone] == 0;
+    }
+
+    int GetZoneCount() const { return (int)zoneCenters.size(); }
+};
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef ROAD_NETWORK_H
+#define ROAD_NETWORK_H
+
+#include "roadgraph.h"
+
+// Gère l'initialisation de tous les nœuds et arcs (Logique, sans rendu)
+void InitializeRoadNetwork(RoadGraph& graph);
+
+#endif
@@ -3,6 +3,9 @@
 
 #include "raylib.h"
 #include <vector>
+#include <stdexcept>
+
+class Frustum; // Rendu de debug uniquement
 
 // Inclusion de votre logique de types
 enum NodeType { START, TELEPORT, DECISION, ARC };
@@ -27,9 +30,37 @@ struct Node {
         : id(id), pos(p), type(t), lightState(LIGHT_NONE), teleportTargetId(-1) {}
 };
 
+// Successors of one node in the finalized graph: a slice of the flat adjacency array
+struct NodeRange {
+    const int* first;
+    const int* last;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return (int)(last - first); }
+    bool empty() const { return first == last; }
+    int operator[](int i) const { return first[i]; }
+};
+
 class RoadGraph {
 private:
     std::vector<Node> nodes; // Conteneur interne des noeuds
+    std::vector<int> indexById; // Node ID -> dense index (-1 = unknown ID)
+
+    // --- FINALIZED FORM (CSR) ---
+    // Built once by Finalize(). Every array is indexed by the dense node index,
+    // the successors of node i are adjacency[edgeOffsets[i] .. edgeOffsets[i + 1]).
+    bool finalized = false;
+    std::vector<int> ids;
+    std::vector<Vector3> positions;
+    std::vector<NodeType> types;
+    std::vector<int> teleportTargets; // Dense index of the teleport target (-1 = none)
+    std::vector<int> edgeOffsets;
+    std::vector<int> adjacency;
+
+    int FindIndex(int id) const; // -1 if unknown
+    int NodeIndex(int id) const; // Index in 'nodes', finalized or not: throws std::out_of_range if unknown
+    void DropFinalized();        // Empties the CSR arrays (the nodes changed)
 
 public:
     RoadGraph();
@@ -39,19 +70,48 @@ public:
     void Clear();
 
     // Méthodes de gestion (Mélange de votre logique et celle du collègue)
+    // Unknown IDs throw std::out_of_range, a duplicate ID throws std::invalid_argument
     void AddNode(int id, Vector3 pos, NodeType type);
     void ConnectNodes(int fromId, int toId);
-    Node& GetNode(int id); // Accès sécurisé au noeud
+    Node& GetNode(int id); // Accès sécurisé au noeud (O(1))
+    const Node& GetNode(int id) const;
+    bool HasNode(int id) const { return FindIndex(id) >= 0; }
     const std::vector<Node>& GetAllNodes() const;
     
     // Pour votre logique de téléportation
     void SetTeleportTarget(int nodeId, int targetId);
 
-    // DESSIN DES SPHÈRES ET DES LIGNES (Dans le monde 3D)
-    void DrawNodes();
+    // Builds the CSR form once the map is complete. Throws std::out_of_range
+    // if an edge or a teleport points to a node that was never added.
+    // Any later AddNode/ConnectNodes/SetTeleportTarget drops the finalized form: the CSR
+    // arrays are emptied (GetNodeCount() == 0) until the next Finalize.
+    void Finalize();
+    bool IsFinalized() const { return finalized; }
+
+    // --- CSR ACCESS (Finalize() first; dense indices are only valid while IsFinalized()) ---
+    // IndexOf is the way to a dense index: it throws std::logic_error while the graph is not
+    // finalized, so no index reaches the (then empty) arrays below.
+    int GetNodeCount() const { return (int)ids.size(); }
+    int IndexOf(int id) const;   // Throws std::out_of_range on an unknown ID
+    int IdOf(int index) const { return ids[index]; }
+    Vector3 PositionOf(int index) const { return positions[index]; }
+    NodeType TypeOf(int index) const { return types[index]; }
+    int TeleportTargetOf(int index) const { return teleportTargets[index]; }
+    NodeRange Successors(int index) const {
+        const int* base = adjacency.data();
+        return { base + edgeOffsets[index], base + edgeOffsets[index + 1] };
+    }
+    // Dense edge indices: edge k is the k-th entry of the adjacency array
+    int GetEdgeCount() const { return (int)adjacency.size(); }
+    int FirstEdge(int index) const { return edgeOffsets[index]; }
+    int FindEdge(int fromIndex, int toIndex) const; // -1 if not connected
+
+    // --- Rendu de debug (roadgraph_draw.cpp, hors du noyau headless) ---
+    // DESSIN DES SPHÈRES ET DES LIGNES (Dans le monde 3D), hors de 'view' ignorés
+    void DrawNodes(const Frustum& view) const;
 
-    // DESSIN DES TEXTES (IDs)
-    void DrawIdNodes(Camera3D camera);
+    // DESSIN DES TEXTES (IDs): seuls les nœuds dans 'view' (même frustum que la 3D)
+    void DrawIdNodes(Camera3D camera, const Frustum& view) const;
 };
 
 #endif
\ No newline at end of file
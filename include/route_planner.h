@@ -0,0 +1,132 @@
+#ifndef ROUTE_PLANNER_H
+#define ROUTE_PLANNER_H
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include "roadgraph.h"
+
+class JobSystem;
+
+// Shortest paths from every node to one destination (reverse Dijkstra)
+struct ShortestPathTree {
+    int destination = -1;
+    std::vector<float> cost;   // Cost left to the destination, ROUTE_UNREACHABLE if none
+    std::vector<int> next;     // Next node on the way, -1 at the destination / unreachable
+
+    bool Reaches(int node) const { return next[node] >= 0 || node == destination; }
+    // origin ... destination (dense indices), empty if unreachable
+    void PathFrom(int origin, std::vector<int>& path) const;
+};
+
+static const float ROUTE_UNREACHABLE = 1.0e30f;
+
+struct RouteRequest {
+    int origin;        // Dense node indices
+    int destination;
+};
+
+// Origin/destination routing over a finalized RoadGraph.
+// Edge cost = edge length (meters) until SetEdgeCosts. A route never goes through a TELEPORT
+// node (vehicles jump there), it can only end on one.
+// - FindRoute: one A* query (heuristic: straight-line distance x cheapest cost per meter)
+// - TreeTo: shortest-path tree to a destination, from an LRU cache (thread safe)
+// - PlanBatch: many requests at once, missing trees and paths computed in parallel
+class RoutePlanner {
+private:
+    const RoadGraph* graph = nullptr;
+    std::vector<float> edgeCost;          // By dense edge index (RoadGraph adjacency order)
+    float costPerMeter = 1.0f;            // Lowest cost / length over the edges (A* heuristic)
+    // Reverse CSR: the edges entering node v are reverseEdge[reverseOffsets[v] .. reverseOffsets[v + 1])
+    std::vector<int> reverseOffsets;
+    std::vector<int> reverseFrom;
+    std::vector<int> reverseEdge;
+    std::vector<int> edgeFrom;            // Dense edge -> its source node
+
+    typedef std::shared_ptr<const ShortestPathTree> TreePtr;
+    std::list<TreePtr> lru;                              // Most recently used first
+    std::unordered_map<int, std::list<TreePtr>::iterator> cached;   // Destination -> entry
+    size_t cacheCapacity = 64;
+    long long cacheHits = 0;
+    long long cacheMisses = 0;
+    mutable std::mutex cacheMutex;
+
+    float EdgeLength(int edge, int from) const;
+    TreePtr Lookup(int destination);          // nullptr if not cached (cacheMutex held)
+    void Insert(const TreePtr& tree);         // cacheMutex held
+
+public:
+    // Prepares the planner for a finalized graph (the graph must outlive the planner's use)
+    void Build(const RoadGraph& graph);
+    bool IsBuilt() const { return graph != nullptr; }
+
+    // Replaces the edge costs (one per dense edge, >= 0) and drops the cached trees
+    void SetEdgeCosts(const std::vector<float>& costs);
+    const std::vector<float>& GetEdgeCosts() const { return edgeCost; }
+
+    // A* from 'origin' to 'destination'; false (and 'path' empty) if unreachable
+    bool FindRoute(int origin, int destination, std::vector<int>& path, float* cost = nullptr) const;
+
+    // Dijkstra over the reverse graph, not cached
+    void ComputeTree(int destination, ShortestPathTree& tree) const;
+    // Cached tree to 'destination' (stays valid after eviction)
+    std::shared_ptr<const ShortestPathTree> TreeTo(int destination);
+
+    // routes[i] = path of requests[i] (empty if unreachable). One tree per distinct
+    // destination, built in parallel on 'jobs' when given (call outside of a job graph run).
+    void PlanBatch(const std::vector<RouteRequest>& requests, std::vector<std::vector<int>>& routes,
+                   JobSystem* jobs = nullptr);
+    // trees[d] = tree to destinations[d], not cached, built in parallel on 'jobs' when given
+    void ComputeTrees(const std::vector<int>& destinations, std::vector<std::shared_ptr<ShortestPathTree>>& trees,
+                      JobSystem* jobs = nullptr) const;
+
+    // --- Incremental updates ---
+    struct EdgeChange {
+        int edge;
+        float oldCost;
+        float newCost;
+    };
+    // Takes the edges of 'costs' that moved by more than 'tolerance' (relative) from the current
+    // costs, returns them and drops the cached trees. The other edges keep their current cost.
+    std::vector<EdgeChange> UpdateEdgeCosts(const std::vector<float>& costs, float tolerance = 0.0f);
+    // Brings a tree built before 'changes' up to date (UpdateEdgeCosts first). Only the nodes whose
+    // route used a costlier edge are recomputed, and only the nodes a cheaper edge improves are
+    // visited. Returns the number of nodes visited.
+    int RepairTree(ShortestPathTree& tree, const std::vector<EdgeChange>& changes) const;
+
+    void SetCacheCapacity(size_t capacity);
+    void ClearCache();
+    size_t GetCachedTreeCount() const;
+    long long GetCacheHits() const;
+    long long GetCacheMisses() const;
+};
+
+// Routes to the exits, shared by the vehicles that follow them: one shortest-path tree per
+// destination, so a vehicle only keeps a route ID (the destination slot) and reads its next
+// node from the tree on arrival. Never changed once handed to the vehicles: new costs give a
+// new table (see RouteRefresher), with the same route IDs.
+class RouteTable {
+private:
+    std::vector<std::shared_ptr<const ShortestPathTree>> trees;   // Route ID -> tree
+    std::vector<std::vector<int>> routesFrom;   // Origin node -> routes that can be taken from it
+
+public:
+    void Clear(int nodeCount);
+    // Route to tree->destination, from every node of the tree except the destination. Returns its ID.
+    int Add(std::shared_ptr<const ShortestPathTree> tree);
+
+    int GetRouteCount() const { return (int)trees.size(); }
+    int DestinationOf(int routeId) const { return trees[routeId]->destination; }
+    const ShortestPathTree& TreeOf(int routeId) const { return *trees[routeId]; }
+    // Node after 'node' on the route (dense indices), -1 at the destination or off the route
+    int NextNode(int routeId, int node) const { return trees[routeId]->next[node]; }
+    // origin ... destination, empty if the route cannot be taken from 'origin'
+    void PathFrom(int routeId, int origin, std::vector<int>& path) const { trees[routeId]->PathFrom(origin, path); }
+    // One of the routes that can be taken from 'origin', picked with the vehicle's generator; -1 if none
+    int PickFrom(int origin, uint32_t& seed) const;
+};
+
+#endif
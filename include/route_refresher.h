@@ -0,0 +1,70 @@
+#ifndef ROUTE_REFRESHER_H
+#define ROUTE_REFRESHER_H
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "route_planner.h"
+
+class JobSystem;
+
+// Keeps the routes to a fixed set of destinations up to date with changing edge costs, on a
+// thread of its own. Each Submit hands over new costs; the worker repairs its trees (only
+// what the changed edges affect, see RoutePlanner::RepairTree) and publishes a new RouteTable
+// with one atomic pointer swap. Readers keep the table they hold for as long as they need it.
+class RouteRefresher {
+private:
+    RoutePlanner planner;                                  // Worker side once started
+    std::vector<std::shared_ptr<ShortestPathTree>> trees;  // Worker's own copies, repaired in place
+    std::shared_ptr<const RouteTable> published;           // std::atomic_load / std::atomic_store only
+    int nodeCount = 0;
+
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable wake;     // Worker: a job or Stop
+    std::condition_variable done;     // WaitIdle: job finished
+    std::vector<float> pendingCosts;
+    bool hasJob = false;
+    bool busy = false;
+    bool stopping = false;
+    // Counters (mutex)
+    long long refreshCount = 0;
+    long long repairedNodes = 0;
+    double lastRefreshTime = 0.0;
+
+    void Run();
+    void Refresh(const std::vector<float>& costs);
+    void Publish();
+
+public:
+    // Cost changes below this (relative) are ignored: no repair for noise
+    static constexpr float COST_TOLERANCE = 0.05f;
+
+    RouteRefresher() {}
+    ~RouteRefresher() { Stop(); }
+    RouteRefresher(const RouteRefresher&) = delete;
+    RouteRefresher& operator=(const RouteRefresher&) = delete;
+
+    // Plans the trees to 'destinations' with 'costs' (in parallel on 'jobs', before returning),
+    // publishes the first table and starts the worker. Restarts it if it was running.
+    void Start(const RoadGraph& graph, const std::vector<int>& destinations, const std::vector<float>& costs,
+               JobSystem* jobs = nullptr);
+    void Stop();
+    bool IsRunning() const { return worker.joinable(); }
+
+    // New costs (one per dense edge); replaces a job the worker has not started yet
+    void Submit(const std::vector<float>& costs);
+    // Until the submitted costs are published (or found unchanged)
+    void WaitIdle();
+
+    // Latest published routes (never null once started)
+    std::shared_ptr<const RouteTable> GetRoutes() const { return std::atomic_load(&published); }
+
+    long long GetRefreshCount() const;         // Jobs that changed some routes
+    long long GetRepairedNodeCount() const;    // Nodes visited by the tree repairs, all jobs
+    double GetLastRefreshTime() const;         // Seconds of the last job
+};
+
+#endif
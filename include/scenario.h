@@ -0,0 +1,19 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <string>
+#include <istream>
+#include "config.h"
+
+// Plain-text scenario for headless runs, one directive per line ('#' starts a comment):
+//   seed 42
+//   max_vehicles 500
+//   tick_rate 60                  <- fixed simulation ticks per sim second
+//   threads 8                     <- threads for the vehicle update (0 = one per core), results do not depend on it
+//   vehicle Car 40 0 1 26 27      <- type, count, start node IDs
+// Values not given keep those of 'base'. Any 'vehicle' line replaces the whole vehicle list.
+// Throws std::runtime_error (with the line number) on a malformed scenario.
+SimulationConfig ParseScenario(std::istream& in, const SimulationConfig& base);
+SimulationConfig LoadScenario(const std::string& path, const SimulationConfig& base);
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SIM_PACER_H
+#define SIM_PACER_H
+
+#include "simulation_core.h"
+
+// Paces the fixed-step loop against the wall clock for high speed factors (turbo).
+// Speed never stretches the tick: a faster run means more ticks per frame, bounded by a
+// CPU budget. When the budget is not enough the frame is not rendered (up to
+// MAX_SKIPPED_FRAMES in a row) so the time goes to ticks, and the rest is dropped:
+// the sim then runs slower than asked instead of spiralling.
+class SimPacer {
+private:
+    double tickCost = 0.0005;   // Wall seconds per tick (EWMA)
+    bool behind = false;
+    int skippedFrames = 0;
+
+    // Achieved rate, measured over a short window
+    double windowWall = 0.0;
+    double windowSim = 0.0;
+    double achievedRate = 0.0;
+
+public:
+    static constexpr double FRAME_BUDGET = 0.012;   // Wall seconds of ticks per frame
+    static constexpr int MAX_SKIPPED_FRAMES = 8;     // Render at least every 9th frame
+    static constexpr double RATE_WINDOW = 0.5;       // Seconds between two rate readings
+
+    // Advances 'sim' by 'wallDt * speed' of sim time (as far as the budget allows).
+    // Returns true if this frame should be rendered.
+    bool RunFrame(SimulationCore& sim, float wallDt, float speed);
+    void Reset();
+
+    // Sim-seconds per wall-second actually simulated (0 until the first reading)
+    double GetAchievedRate() const { return achievedRate; }
+    bool IsBehind() const { return behind; }
+    // Ticks that fit in FRAME_BUDGET at the measured tick cost
+    int GetTickBudget() const;
+};
+
+#endif
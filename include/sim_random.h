@@ -0,0 +1,29 @@
+#ifndef SIM_RANDOM_H
+#define SIM_RANDOM_H
+
+#include <cstdint>
+
+// Small deterministic generator (xorshift32) for the simulation core.
+// Same seed -> same run, without raylib's global GetRandomValue.
+struct SimRandom {
+    uint32_t state;
+
+    explicit SimRandom(uint32_t seed = 1) { Seed(seed); }
+
+    void Seed(uint32_t seed) { state = seed ? seed : 0x9E3779B9u; } // xorshift must not start at 0
+
+    uint32_t Next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Between min and max included (same contract as GetRandomValue)
+    int Range(int min, int max) {
+        if (max <= min) return min;
+        return min + (int)(Next() % (uint32_t)(max - min + 1));
+    }
+};
+
+#endif
@@ -2,30 +2,42 @@
 #define SIMULATION_H
 
 #include "raylib.h"
-#include <vector>
-#include <memory>
-
-#include "roadgraph.h"
-#include "vehicle.h"
-#include "traffic_manager.h"
-#include "spawner.h"
+#include "simulation_core.h"
+#include "sim_pacer.h"
+#include "mesh_builder.h"
+#include "city_buildings.h"
+#include "vehicle_renderer.h"
 
+// Interactive front end of the simulation: mouse picking and rendering around a SimulationCore
 class Simulation {
 private:
-    RoadGraph roadGraph;
-    TrafficManager trafficMgr;
-    VehicleSpawner spawner;
-    std::vector<std::unique_ptr<Vehicle>> vehicles;
+    SimulationCore core;
+    SimPacer pacer;          // Ticks per frame / frame skipping at high speed
+    bool renderFrame = true;
+    BakedGeometry staticMap;   // Roads, sidewalks, markings (baked by Init)
+    CityBuildings buildings;   // Building prototypes and their placements (loaded by Init)
+    VehicleRenderer vehicleRenderer;   // Instanced vehicle bodies (loaded by Init)
+    Frustum view;              // Camera volume of the frame being drawn (Draw3D), reused by DrawOverlay
 
 public:
+    // Side of the square tiles the baked map is culled by
+    static constexpr float MAP_TILE_SIZE = 40.0f;
+
     Simulation();
     void Init();
     void ApplyConfiguration();
-    void Update(float dt, Camera3D camera);
-    void Draw3D(bool showDebugNodes); 
+    // 'wallDt' of real time at 'speed' x (the pacer decides how many ticks it becomes)
+    void Update(float wallDt, float speed, Camera3D camera);
+    // False when the last Update fell behind: spend the frame on ticks, not on drawing
+    bool ShouldRender() const { return renderFrame; }
+    // Culls against 'camera' (what BeginMode3D was given)
+    void Draw3D(bool showDebugNodes, Camera3D camera);
     void DrawOverlay(bool showDebugNodes, Camera3D camera);
     int GetVehicleCount() const;
     void Clear();
+
+    SimulationCore& GetCore() { return core; }
+    const SimPacer& GetPacer() const { return pacer; }
 };
 
 #endif
\ No newline at end of file
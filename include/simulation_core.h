@@ -0,0 +1,135 @@
+#ifndef SIMULATION_CORE_H
+#define SIMULATION_CORE_H
+
+#include "roadgraph.h"
+#include "vehicle.h"
+#include "vehicle_pool.h"
+#include "traffic_manager.h"
+#include "spawner.h"
+#include "event_scheduler.h"
+#include "occupancy_index.h"
+#include "job_system.h"
+#include "route_planner.h"
+#include "route_refresher.h"
+#include "travel_times.h"
+#include <memory>
+#include <climits>
+
+// Counters accumulated by SimulationCore::Step (reset with ResetStats)
+// Per vehicle type part of SimulationStats
+struct VehicleTypeStats {
+    int spawned = 0;
+    int completed = 0;
+    long long updates = 0;
+    double speedSum = 0.0;
+
+    double AverageSpeed() const { return updates ? speedSum / updates : 0.0; }
+};
+
+struct SimulationStats {
+    long long ticks = 0;
+    double simTime = 0.0;           // Seconds of simulated time
+    long long vehicleUpdates = 0;   // Sum over ticks of the vehicles moved
+    int spawned = 0;
+    int completed = 0;              // Vehicles that left the network
+    int peakVehicles = 0;
+    double speedSum = 0.0;          // Over all vehicle updates
+    long long stoppedUpdates = 0;   // Vehicle updates below STOPPED_SPEED
+    VehicleTypeStats byType[VEHICLE_TYPE_COUNT];   // Indexed by VehicleType
+
+    static constexpr float STOPPED_SPEED = 0.5f;
+
+    double AverageSpeed() const { return vehicleUpdates ? speedSum / vehicleUpdates : 0.0; }
+    double StoppedRatio() const { return vehicleUpdates ? (double)stoppedUpdates / vehicleUpdates : 0.0; }
+};
+
+// The traffic simulation without any window, input or GL dependency:
+// road network, lights, spawning and vehicle motion stepped by an explicit dt.
+// Used as is by the batch runner and the tests, and wrapped by Simulation for the app.
+class SimulationCore {
+private:
+    EventScheduler events;   // Sim clock: light phases, spawn retries...
+    RoadGraph roadGraph;
+    TrafficManager trafficMgr;
+    VehicleSpawner spawner;
+    OccupancyIndex occupancy;   // Vehicles around spawn points / teleport landings
+    VehiclePool vehicles;
+    // Routes to every exit (see PlanRoutes), refreshed from the observed travel times
+    TravelTimes travelTimes;
+    RouteRefresher router;
+    std::shared_ptr<const RouteTable> routes = std::make_shared<RouteTable>();   // Table the vehicles follow this tick
+    std::vector<float> snapshotCosts;           // Scratch: costs handed to the router
+    int ticksSinceReroute = 0;
+    bool waitForRoutes = true;
+    double routePlanningTime = 0.0;
+    SimulationStats stats;
+    // Tick as a task graph (see BuildStepGraph), on threadCount threads
+    JobSystem jobs;
+    float stepDt = 0.0f;                     // dt of the tick being run
+    size_t animatedFirst = 0;                // First row of the "type behaviour" task (see AnimatedRows)
+    std::vector<unsigned char> atTeleport;   // Scratch: vehicles whose landing is resolved after the parallel pass
+    DriveScratch driveScratch;
+    struct ChunkMetrics {
+        double speedSum = 0.0;
+        long long stoppedUpdates = 0;
+        double typeSpeedSum[VEHICLE_TYPE_COUNT] = {};
+        long long typeUpdates[VEHICLE_TYPE_COUNT] = {};
+    };
+    std::vector<ChunkMetrics> tickMetrics;   // One per VEHICLE_BATCH chunk
+
+    // Fixed-step loop (see Advance)
+    float tickDt = 1.0f / 60.0f;
+    float accumulator = 0.0f;
+
+    void WatchEntryPoints();
+    void PlanRoutes();
+    void RefreshRoutes();
+    void BuildStepGraph();
+
+public:
+    SimulationCore();
+
+    // Builds the road network and starts the traffic lights
+    void Init();
+    // (Re)loads the vehicle demand (and tick rate, thread count) from globalConfig
+    void ApplyConfiguration();
+    // One simulation tick of 'dt' seconds of sim time
+    void Step(float dt);
+    // Fixed-step loop: adds 'dt' of sim time and runs the whole ticks it covers, at most
+    // 'maxTicks' (the remainder waits for the next call). Returns the number of ticks run.
+    int Advance(float dt, int maxTicks = INT_MAX);
+    // Sim time owed but not simulated yet (more than one tick = falling behind)
+    float GetBacklog() const { return accumulator; }
+    // Forgets owed sim time beyond 'maxTicks' ticks (the sim runs slower than asked instead of spiralling)
+    void DropBacklog(int maxTicks);
+    // Fraction of a tick left in the accumulator: render poses between the last two ticks with it
+    float GetInterpolationAlpha() const { return accumulator < tickDt ? accumulator / tickDt : 1.0f; }
+    float GetTickDt() const { return tickDt; }
+    int GetThreadCount() const { return jobs.GetThreadCount(); }
+    // Per-task timing of the tick graph (enable with GetJobs().SetProfiling(true))
+    JobSystem& GetJobs() { return jobs; }
+    void Clear();
+
+    int GetVehicleCount() const { return (int)vehicles.Count(); }
+    int GetQueuedCount() const { return spawner.GetQueuedCount(); }
+    const SimulationStats& GetStats() const { return stats; }
+    void ResetStats() { stats = SimulationStats(); }
+
+    // Routing (planned by ApplyConfiguration, off with globalConfig.routing = false)
+    const RouteTable& GetRoutes() const { return *routes; }
+    const TravelTimes& GetTravelTimes() const { return travelTimes; }
+    const RouteRefresher& GetRouteRefresher() const { return router; }
+    double GetRoutePlanningTime() const { return routePlanningTime; }
+    // true (default): every reroute waits for the routes of the previous one, so a run does not
+    // depend on the timing of the router thread. false: the routes are taken when ready, a tick never waits.
+    void SetRouteSync(bool wait) { waitForRoutes = wait; }
+
+    // Access for the front end (interaction, rendering)
+    VehiclePool& GetVehicles() { return vehicles; }
+    const VehiclePool& GetVehicles() const { return vehicles; }
+    const RoadGraph& GetRoadGraph() const { return roadGraph; }
+    TrafficManager& GetTrafficManager() { return trafficMgr; }
+    EventScheduler& GetClock() { return events; }
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "raylib.h"
+#include <vector>
+#include <cmath>
+
+// Uniform grid over the XZ plane used for neighbour queries.
+// It is rebuilt from scratch once per tick (counting sort, no per-cell allocation),
+// so queries only visit the cells that overlap the search radius.
+class SpatialGrid {
+private:
+    float baseCellSize;        // Requested size
+    float cellSize;            // Size used by the current grid (>= baseCellSize)
+    float minX, minZ;          // World position of cell (0,0)
+    int cols, rows;
+
+    std::vector<int> cellStart; // Offsets into 'entries' (size = cols * rows + 1)
+    std::vector<int> entries;   // Point indices, grouped by cell
+    std::vector<int> pointCell; // Scratch: cell of each point during Build
+    std::vector<int> cursor;    // Scratch: write position per cell during Build
+
+    int CellX(float x) const;
+    int CellZ(float z) const;
+
+public:
+    // cellSize should be in the order of the typical query radius
+    SpatialGrid(float cellSize = 16.0f);
+
+    // Rebuilds the grid. Index i in 'points' is the id reported by queries.
+    void Build(const std::vector<Vector3>& points);
+
+    // Calls fn(index) for every point stored in a cell touching the square
+    // [center - radius, center + radius]. Callers still do their own exact distance test.
+    template <typename Fn>
+    void ForEachNear(Vector3 center, float radius, Fn&& fn) const {
+        if (entries.empty()) return;
+
+        int x0 = CellX(center.x - radius), x1 = CellX(center.x + radius);
+        int z0 = CellZ(center.z - radius), z1 = CellZ(center.z + radius);
+
+        for (int cz = z0; cz <= z1; cz++) {
+            int rowBase = cz * cols;
+            for (int cx = x0; cx <= x1; cx++) {
+                int cell = rowBase + cx;
+                for (int k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                    fn(entries[k]);
+                }
+            }
+        }
+    }
+
+    int GetCellCount() const { return cols * rows; }
+};
+
+#endif
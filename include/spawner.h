@@ -2,24 +2,33 @@
 #define SPAWNER_H
 
 #include <vector>
-#include <string>
 #include <memory>
+#include <deque>
+#include <unordered_map>
 #include "vehicle.h"
+#include "vehicle_pool.h"
 #include "roadgraph.h"
 #include "config.h"
+#include "event_scheduler.h"
+#include "occupancy_index.h"
+#include "sim_random.h"
+#include "route_planner.h"
 
-// Helper struct for the queue
-struct QueuedVehicle {
-    std::string type;
+// Vehicles waiting at one start node, spawned first-in first-out
+struct StartQueue {
     int startNodeId;
+    std::deque<VehicleType> types;
+    double retryAt = 0.0; // Sim time of the next check once the head found its node blocked
 };
 
 class VehicleSpawner {
 private:
-    std::vector<QueuedVehicle> spawnQueue;
+    std::vector<StartQueue> startQueues;          // One per start node
+    std::unordered_map<int, int> queueOfNode;     // Start node ID -> index in startQueues
+    int queuedCount = 0;
+    SimRandom rng;             // Start node picks and per-vehicle route seeds (seeded from the config)
 
-    // The "Factory" helper function
-    std::unique_ptr<Vehicle> CreateVehicle(const std::string& type, Vector3 pos, int targetNodeId);
+    StartQueue& GetQueue(int startNodeId);
 
 public:
     VehicleSpawner();
@@ -27,11 +36,18 @@ public:
     // Reloads the queue from Global Config
     void LoadFromConfig();
 
-    // Checks timers and adds new vehicles to the list if possible
-    void Update(RoadGraph& graph, std::vector<std::unique_ptr<Vehicle>>& vehicles);
+    // Spawns the head of every queue whose start node is clear (cost grows with the
+    // number of start nodes, not with the backlog). When a head is blocked, its queue is
+    // checked again after a retry delay on 'clock' instead of every frame; the other
+    // queues are not held.
+    // With 'routes', each vehicle leaves on a route from its start node (when there is one).
+    void Update(RoadGraph& graph, VehiclePool& vehicles, OccupancyIndex& occupancy, EventScheduler& clock,
+                const RouteTable* routes = nullptr);
     
     // Clears the queue
     void Clear();
+
+    int GetQueuedCount() const { return queuedCount; }
 };
 
 #endif
\ No newline at end of file
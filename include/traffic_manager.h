@@ -3,14 +3,22 @@
 
 #include "raylib.h"
 #include "raymath.h"
-#include "rlgl.h"
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <cstdint>
 #include "roadgraph.h"
+#include "spatial_grid.h"
+#include "event_scheduler.h"
 
 // Forward declaration to avoid circular includes
 // (We only need to know 'Vehicle' exists here)
 class Vehicle; 
+class VehiclePool;
+struct VehicleKinematics;
+class JobSystem;
+class RouteTable;
+class Frustum;
 
 // Separated Traffic Controller Struct
 struct TrafficController {
@@ -22,7 +30,7 @@ struct TrafficController {
     
     // State
     LightState currentState;
-    float timer;
+    EventId phaseEvent;        // Pending phase change on the sim clock (0 = none)
     
     // Timings
     float startRedTime;// Delay before starting (or initial Red duration)
@@ -31,6 +39,25 @@ struct TrafficController {
     float durationRed;
 };
 
+// Signal seen by a vehicle heading to one node (indexed by dense node index)
+struct SignalSlot {
+    int controller = -1;       // Index in 'controllers' (-1 = no traffic light)
+    Vector3 stopLine = {0,0,0}; // Where vehicles stop while it is red/yellow
+};
+
+// One vehicle on a lane (graph edge), 's' = distance travelled along the edge
+struct LaneSlot {
+    int vehicle;   // Index in the vehicles list
+    float s;
+};
+
+// Occupants of one graph edge, sorted by 's' (tail first, head last)
+struct Lane {
+    int toId;
+    float length;
+    std::vector<LaneSlot> slots;
+};
+
 // The TrafficManager handles collision avoidance and speed regulation.
 // It acts as the "brain" for the simulation's traffic rules.
 class TrafficManager {
@@ -42,12 +69,54 @@ private:
 
     std::vector<TrafficController> controllers; 
 
+    // --- Sim Clock (set by StartLights) ---
+    EventScheduler* clock = nullptr;
+    RoadGraph* lightGraph = nullptr;    // Receives Node::lightState on every phase change
+
+    // --- Signals (node -> controller table, see BindSignals) ---
+    std::vector<SignalSlot> signals;
+    bool signalsDirty = true;
+
+    // --- Neighbour Search ---
+    SpatialGrid vehicleGrid;            // Rebuilt once per UpdateVehicles call
+    std::vector<Vector3> gridPoints;    // Scratch: vehicle positions fed to the grid
+
+    // --- Lanes (one per graph edge, rebuilt every tick) ---
+    std::unordered_map<long long, Lane> lanes;
+    std::unordered_map<int, std::vector<Lane*>> lanesInto; // Occupied lanes per target node (merges have several)
+    std::vector<int> laneRank;          // Per vehicle: index in its lane (-1 = not on a known edge)
+
+    // --- Double buffer: speeds of the tick being computed (swapped with the kinematics at the end) ---
+    std::vector<float> nextSpeed;
+    // Speed control inputs gathered per vehicle (SoA, fed to SpeedControlBatch)
+    std::vector<float> gapInput;
+    std::vector<float> leaderSpeedInput;
+    std::vector<int32_t> speedMode;
+    double updateTime = 0.0;            // Sim time of the tick being computed (BeginUpdate)
+    const RouteTable* routes = nullptr; // Planned routes: a routed vehicle only looks down its own route
+
     // --- Internal Helper Functions ---
-    float GetDistance(const Vector3& a, const Vector3& b);  // Calculates Euclidean distance between two 3D points
-    bool AreSameDirection(const Vector3& dir1, const Vector3& dir2);  // Direction Check (Are we parallel?)
-    bool IsInMyLane(Vehicle* me, Vehicle* other);  // Lane Check (Only for parallel cars)
+    float GetDistance(const Vector3& a, const Vector3& b) const;  // Calculates Euclidean distance between two 3D points
+    bool AreSameDirection(const Vector3& dir1, const Vector3& dir2) const;  // Direction Check (Are we parallel?)
     float Lerp(float start, float end, float amount);   // Linear Interpolation helper for smooth braking
 
+    // Lane helpers
+    static long long EdgeKey(int fromId, int toId);
+    float DistanceAlongEdge(const Vector3& pos, const RoadGraph& map, int fromId, int toId) const;
+    // Closest vehicle that reaches 'nodeId' before us, 'distToNode' being our own distance to it
+    // (vehicle indices are rows of VehicleKinematics, -1 = none)
+    int FindAheadAtNode(int nodeId, float distToNode, int me, const VehicleKinematics& k, float& gapOut) const;
+    // Next vehicle ahead: on our own edge (or merging into our node), else the first one found downstream
+    int FindLeader(size_t index, const VehicleKinematics& k, const RoadGraph& map, float range, float& gapOut) const;
+    // Light, leader and crossing checks of vehicle 'index' from the previous tick only:
+    // fills its speed control inputs (safe to call from any thread, each index writes its own slot)
+    void GatherSpeedInput(size_t index, const VehicleKinematics& k, const RoadGraph& map, double now);
+
+    // Signal phases: one scheduled event per controller, nothing is polled per frame
+    float GetPhaseDuration(const TrafficController& ctrl) const;
+    void SchedulePhaseChange(size_t index);
+    void AdvancePhase(size_t index);
+
     // NEW: Specific rendering function for lights
     void DrawTrafficLightModel(Vector3 pos, float angleY, LightState state);
 
@@ -58,13 +127,31 @@ public:
     // Setup & Config
     void AddController(int id, std::vector<int> nodeIds);
     void ConfigureTrafficLight(int controllerId, Vector3 position, float rotation, float startRedTime, float greenTime, float yellowTime, float redTime);
+    // Rebuilds the node -> controller table (call after the graph or the controllers change).
+    // Throws std::out_of_range if a controller manages a node that is not in the graph.
+    void BindSignals(const RoadGraph& map);
     
-    // Draw Loop
-    void Draw();
+    // Draw Loop (traffic_manager_draw.cpp, not part of the headless core), lights out of 'view' skipped
+    void Draw(const Frustum& view);
     
+    // Starts the light cycles on the sim clock (call once the controllers are configured)
+    void StartLights(EventScheduler& clock, RoadGraph& map);
+    // Routes followed by the vehicles (nullptr = every branch ahead is checked)
+    void SetRoutes(const RouteTable* table) { routes = table; }
+
     // Update Loops
-    void UpdateLights(float dt, RoadGraph& map); 
-    void UpdateVehicles(std::vector<std::unique_ptr<Vehicle>>& vehicles, const RoadGraph& map);
+    // Every vehicle reads the previous tick and writes its own new speed, so the result is the
+    // same for any update order: split across 'workers' when given, inline otherwise.
+    void UpdateVehicles(VehiclePool& vehicles, const RoadGraph& map, float dt, JobSystem* workers = nullptr);
+
+    // The same update in steps, for a task graph (see SimulationCore):
+    // BeginUpdate, then BuildGrid and BuildLanes (independent), then ComputeSpeeds over
+    // any split of the vehicles, then CommitSpeeds
+    void BeginUpdate(const VehicleKinematics& k, const RoadGraph& map);
+    void BuildGrid(const VehicleKinematics& k);
+    void BuildLanes(const VehicleKinematics& k, const RoadGraph& map);
+    void ComputeSpeeds(size_t begin, size_t end, const VehicleKinematics& k, const RoadGraph& map, float dt);
+    void CommitSpeeds(VehicleKinematics& k);
 };
 
 #endif // TRAFFIC_MANAGER_H
\ No newline at end of file
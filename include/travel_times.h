@@ -0,0 +1,37 @@
+#ifndef TRAVEL_TIMES_H
+#define TRAVEL_TIMES_H
+
+#include <vector>
+#include "roadgraph.h"
+
+struct VehicleKinematics;
+
+// Travel time estimate of every edge (seconds, by dense edge index), learnt from the vehicles:
+// each time a vehicle reaches the end of an edge, the time it took is blended into the
+// estimate (exponentially weighted moving average). Unobserved edges keep their free-flow time.
+class TravelTimes {
+private:
+    std::vector<float> estimates;
+    std::vector<float> freeFlow;
+    long long observations = 0;
+
+public:
+    static constexpr float SMOOTHING = 0.3f;   // Weight of a new observation
+
+    // Free-flow times (length / freeFlowSpeed) for every edge of a finalized graph
+    void Reset(const RoadGraph& graph, float freeFlowSpeed);
+
+    void Observe(int edge, float seconds);
+    // Folds the edges the vehicles finished this tick (VehicleKinematics::doneEdge) and clears them
+    void Collect(VehicleKinematics& k);
+
+    // Estimates, raised to the time already spent by the vehicles still on an edge (a queue
+    // shows up before anyone gets through it): the costs handed to the router
+    void Snapshot(const VehicleKinematics& k, const RoadGraph& graph, std::vector<float>& costs) const;
+
+    const std::vector<float>& GetEstimates() const { return estimates; }
+    const std::vector<float>& GetFreeFlowTimes() const { return freeFlow; }
+    long long GetObservationCount() const { return observations; }
+};
+
+#endif
@@ -6,106 +6,105 @@
 #include <cmath>
 #include <memory>
 
-#include "config.h"    // Pour CONFIG::TRUCK_SPEED, etc.
+#include "config.h"    // Pour CONFIG::ARRIVAL_THRESHOLD, etc.
 #include "roadgraph.h" // Pour la classe RoadGraph et la structure Node
-#include "model_manager.h" // Pour la gestion des modèles 3D
+#include "occupancy_index.h" // Entry points déjà occupés (téléportation)
+#include "vehicle_state.h" // Etat cinématique (tableaux SoA)
+#include "vehicle_types.h" // Registre des types de véhicules
+#include "frustum.h"       // Culling du rendu
+
+class ModelManager; // Rendu uniquement (voir vehicle_draw.cpp)
+class VehicleRenderer;
+class VehiclePool;
+class RouteTable;   // Routes suivies par les véhicules (route_planner.h)
+
+// Scratch of Vehicle::DriveRange, indexed like the kinematics rows (sized by the caller)
+struct DriveScratch {
+    std::vector<float> targetX, targetY, targetZ;
+    std::vector<int32_t> active;
+    std::vector<unsigned char> arrived;
+
+    void Resize(size_t count);
+};
 
 // ----- Classes de Base -----
+// Cold part of a vehicle: rendering / UI attributes and the state of the per-type behaviour.
+// The kinematic state (position, speed, target...) lives in VehicleKinematics, see vehicle_state.h;
+// the per-type constants and behaviour are compile-time traits, see vehicle_traits.h.
 class Vehicle {
 public:
-    Vector3 position;
-    Vector3 forward;
-    float speed;
-    float desiredSpeed;
-    float length;
-    int targetNodeId;
     Color color;
     Color originalColor;
-    bool finished = false;
-    float forceMoveTimer = 0.0f;
 
-    // Static model manager (shared by all vehicles)
+    // Static model manager (shared by all vehicles, set by the renderer)
     static ModelManager* modelManager;
 
-    // NEW: Model type identifier
-    std::string modelType;
+    // Registry entry (model, speed, length...)
+    VehicleType type;
 
-    // Constructeur
-    Vehicle(Vector3 pos, int initialTargetId);
+    // Constructeur (couleur et modèle du type, voir VEHICLE_TYPE_LIST)
+    explicit Vehicle(VehicleType type);
 
     virtual ~Vehicle();
 
-    // MISE À JOUR : Utilise RoadGraph au lieu de std::vector<Node>
-    virtual void update(float dt, RoadGraph &graph, const std::vector<std::unique_ptr<Vehicle>>& allVehicles);
-
-    virtual void draw();
-};
-
-class Car : public Vehicle {
-public:
-    // Pass pos and targetId to the base Vehicle constructor
-    Car(Vector3 pos, int targetId);
-
-    // Override the draw function to render a detailed car
-    void draw() override;
+    // Moves vehicle 'i' one step along the RoadGraph (arrival, teleport, steering).
+    // With 'routes', a vehicle with a route follows it (and takes a new one after its
+    // destination teleport), otherwise it turns at random.
+    static void Move(VehicleKinematics& k, size_t i, float dt, const RoadGraph &graph, OccupancyIndex& occupancy,
+                     const RouteTable* routes = nullptr);
+    // Move split for the parallel update: Drive only touches row 'i' and returns true when the
+    // vehicle stands on a teleport node, Teleport then does the (shared) landing check
+    static bool Drive(VehicleKinematics& k, size_t i, float dt, const RoadGraph &graph, const RouteTable* routes = nullptr);
+    static void Teleport(VehicleKinematics& k, size_t i, const RoadGraph &graph, OccupancyIndex& occupancy,
+                         const RouteTable* routes = nullptr);
+    // Arrival at the target node (next edge, dead end); returns true on a teleport node
+    static bool Arrive(VehicleKinematics& k, size_t i, const RoadGraph &graph, const RouteTable* routes = nullptr);
+    // Drive over rows [begin, end): steering and integration in SIMD batches (SteerBatch),
+    // arrivals one by one. atTeleport[i] is set like Drive's result.
+    static void DriveRange(VehicleKinematics& k, size_t begin, size_t end, float dt, const RoadGraph &graph,
+                           DriveScratch& scratch, unsigned char* atTeleport, const RouteTable* routes = nullptr);
+    // Per-type behaviour (VehicleTraits<T>::Animate) of rows [begin, end), one loop per animated type group
+    static void AnimateRange(VehiclePool& pool, size_t begin, size_t end, float dt);
+    // Rows [first, end) spanning the groups of the types with a behaviour (ANIMATED traits)
+    static void AnimatedRows(const VehiclePool& pool, size_t& first, size_t& end);
+
+    // Rendering lives in vehicle_draw.cpp (not linked into the headless core):
+    // every vehicle in 'view' at its interpolated pose, one loop per type group (one model lookup
+    // per type). With a loaded 'instancing' renderer the bodies are queued and drawn instanced per type,
+    // at a level of detail set by the distance to the eye of 'view'.
+    static void DrawAll(const VehiclePool& pool, float alpha, const Frustum& view,
+                        VehicleRenderer* instancing = nullptr);
 };
 
-class Bus : public Vehicle {
-public:
-    // Pass pos and targetId to the base Vehicle constructor
-    Bus(Vector3 pos, int targetId);
+// One class per entry of VEHICLE_TYPE_LIST (vehicle_types.h), holding its per-vehicle state
 
-    void draw() override;
-};
+// Registry entry of each vehicle class
+template <typename T> struct VehicleTypeOf;
+#define X(ID, CLASS, ...) class CLASS; \
+    template <> struct VehicleTypeOf<CLASS> { static constexpr VehicleType value = VEHICLE_##ID; };
+VEHICLE_TYPE_LIST(X)
+#undef X
 
-class Truck : public Vehicle {
+template <typename T>
+class VehicleOf : public Vehicle {
 public:
-    Truck(Vector3 pos, int targetId);
-
-    void draw() override;
+    VehicleOf() : Vehicle(VehicleTypeOf<T>::value) {}
 };
 
-class Taxi : public Vehicle {
-private:
-    float signBlinkTimer = 0.0f;
-    
-public:
-    // Constructeur adapté à votre système (position + cible)
-    Taxi(Vector3 pos, int targetId);
-
-    // Mise à jour de la logique spécifique (clignotant du toit)
-    void update(float dt, RoadGraph &graph, const std::vector<std::unique_ptr<Vehicle>> &allVehicles) override;
+class Car : public VehicleOf<Car> {};
 
-    void draw() override;
-};
+class Bus : public VehicleOf<Bus> {};
 
-class PoliceCar : public Vehicle {
-private:
-    float sirenTimer = 0.0f;
-    
-public:
-    // Constructeur adapté : prend la position de départ et l'ID du premier noeud cible
-    PoliceCar(Vector3 pos, int targetId);
+class Truck : public VehicleOf<Truck> {};
 
-    // Mise à jour de la sirène et de la navigation
-    void update(float dt, RoadGraph &graph, const std::vector<std::unique_ptr<Vehicle>> &allVehicles) override;
+class Taxi : public VehicleOf<Taxi> {};
 
-    void draw() override;
-};
+class PoliceCar : public VehicleOf<PoliceCar> {};
 
-class Motorcycle : public Vehicle {
-private:
-    float tiltAngle = 0.0f;
-    Vector3 lastForward = {1, 0, 0};
-    
+class Motorcycle : public VehicleOf<Motorcycle> {
 public:
-    // Constructeur adapté : position de départ et ID du premier nœud cible
-    Motorcycle(Vector3 pos, int targetId);
-
-    // Mise à jour de l'inclinaison et de la navigation
-    void update(float dt, RoadGraph &graph, const std::vector<std::unique_ptr<Vehicle>> &allVehicles) override;
-
-    void draw() override;
+    float tiltAngle = 0.0f;        // Degrés, roulis autour de la direction
+    float lastForwardX = 1.0f, lastForwardZ = 0.0f;
 };
 
 #endif // VEHICLE_H
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef VEHICLE_LOD_H
+#define VEHICLE_LOD_H
+
+#include "raylib.h"
+
+// Levels of detail of a vehicle body, by distance to the camera (see VehicleRenderer)
+enum VehicleLod : unsigned char {
+    VEHICLE_LOD_FULL,      // The model as loaded
+    VEHICLE_LOD_REDUCED,   // The model simplified at load (SimplifyMesh)
+    VEHICLE_LOD_BOX,       // One flat-shaded box around the model
+    VEHICLE_LOD_COUNT
+};
+
+struct VehicleLodConfig {
+    float reducedDistance = 80.0f;   // Beyond: reduced meshes
+    float boxDistance = 200.0f;      // Beyond: box (the camera zooms out to 400)
+    float hysteresis = 8.0f;         // A level changes this far past its distance, both ways
+    int reducedCells = 16;           // Simplification grid: cells along the longest side of the model
+};
+
+// Level of a vehicle at 'distance' that was at 'current' last frame: a level starts at its
+// distance + hysteresis and ends at its distance - hysteresis, so a vehicle sitting on a
+// boundary does not flicker between two levels. Any level can be reached in one call.
+VehicleLod SelectVehicleLod(VehicleLod current, float distance, const VehicleLodConfig& config);
+
+// Vertex clustering: the vertices are merged per cell of a 'cellSize' grid (aligned on the
+// origin, so meshes of one model simplified with the same size stay joined) and the triangles
+// that collapse are dropped. Keeps normals, texcoords and colors (cell averages) when the mesh
+// has them. Returns CPU data only (indexed, UploadMesh not called): empty if nothing remains.
+Mesh SimplifyMesh(const Mesh& mesh, float cellSize);
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef VEHICLE_POOL_H
+#define VEHICLE_POOL_H
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "vehicle.h"
+#include "vehicle_traits.h"
+
+// Refers to a vehicle without owning it. Stays safe after the vehicle is removed:
+// the slot generation changes, so VehiclePool::Get returns nullptr for stale handles.
+struct VehicleHandle {
+    int slot = -1;
+    unsigned int generation = 0;
+
+    bool operator==(const VehicleHandle& o) const { return slot == o.slot && generation == o.generation; }
+    bool operator!=(const VehicleHandle& o) const { return !(*this == o); }
+};
+
+// Largest vehicle class: every slot can hold any of them
+constexpr size_t MaxOf(const size_t* values, size_t count) {
+    size_t largest = 0;
+    for (size_t i = 0; i < count; i++) largest = values[i] > largest ? values[i] : largest;
+    return largest;
+}
+#define X(ID, CLASS, ...) sizeof(CLASS),
+static constexpr size_t VEHICLE_CLASS_SIZES[] = { VEHICLE_TYPE_LIST(X) };
+#undef X
+#define X(ID, CLASS, ...) alignof(CLASS),
+static constexpr size_t VEHICLE_CLASS_ALIGNS[] = { VEHICLE_TYPE_LIST(X) };
+#undef X
+
+static constexpr size_t VEHICLE_SLOT_SIZE  = MaxOf(VEHICLE_CLASS_SIZES, VEHICLE_TYPE_COUNT);
+static constexpr size_t VEHICLE_SLOT_ALIGN = MaxOf(VEHICLE_CLASS_ALIGNS, VEHICLE_TYPE_COUNT);
+
+// Pooled vehicle store.
+// - Slots are allocated by chunks (addresses never move) and recycled through a free list,
+//   so steady-state spawning/removal does not touch the allocator.
+// - Live vehicles are also kept in a dense array (iteration order), grouped by type: the rows
+//   of a type are [GroupBegin(type), GroupEnd(type)), in registry order. Creation and removal
+//   keep the groups packed with one row swap per following group (no shifting).
+// - The hot state of live vehicle 'i' is row 'i' of the kinematics arrays (kept in the same order).
+class VehiclePool {
+private:
+    static const int CHUNK_SLOTS = 256;
+
+    struct Slot {
+        typename std::aligned_storage<VEHICLE_SLOT_SIZE, VEHICLE_SLOT_ALIGN>::type storage;
+        unsigned int generation = 0;
+        int dense = -1;             // Index in 'live' (-1 = free)
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    std::vector<int> freeSlots;     // Used as a stack
+    std::vector<Vehicle*> live;     // Dense: live vehicles in iteration order
+    std::vector<int> liveSlot;      // Slot of each live vehicle
+    VehicleKinematics kin;          // Hot state, same order as 'live'
+    size_t groupStart[VEHICLE_TYPE_COUNT + 1] = {}; // First row of each type group, then Count()
+
+    Slot& SlotAt(int slot) const { return chunks[slot / CHUNK_SLOTS][slot % CHUNK_SLOTS]; }
+    void AddChunk();
+    int AcquireSlot();
+    void SwapRows(size_t a, size_t b);
+    size_t MoveLastIntoGroup(VehicleType type);  // The new last row joins its group, returns its row
+    void RemoveAt(size_t denseIndex);     // Destroys, the groups stay packed
+
+public:
+    VehiclePool() {}
+    ~VehiclePool();
+    VehiclePool(const VehiclePool&) = delete;
+    VehiclePool& operator=(const VehiclePool&) = delete;
+
+    // Preallocates slots so that 'capacity' vehicles fit without allocation
+    void Reserve(int capacity);
+    int GetCapacity() const { return (int)chunks.size() * CHUNK_SLOTS; }
+
+    // Speed, desired speed and length of the new row come from the registry entry of the type
+    template <typename T>
+    VehicleHandle Create(const VehicleState& state) {
+        static_assert(std::is_base_of<Vehicle, T>::value, "VehiclePool only stores vehicles");
+        static_assert(sizeof(T) <= VEHICLE_SLOT_SIZE && alignof(T) <= VEHICLE_SLOT_ALIGN, "Add the type to VEHICLE_TYPE_LIST");
+        const VehicleType type = VehicleTraits<T>::TYPE;
+        const VehicleTypeInfo& info = GetVehicleTypeInfo(type);
+
+        int slot = AcquireSlot();
+        Slot& s = SlotAt(slot);
+        T* v = new (&s.storage) T();
+
+        VehicleState row = state;
+        row.speed = info.speed;
+        row.desiredSpeed = info.speed;
+        row.length = info.length;
+
+        s.dense = (int)live.size();
+        live.push_back(v);
+        liveSlot.push_back(slot);
+        kin.PushBack(row);
+        size_t index = MoveLastIntoGroup(type);
+        VehicleTraits<T>::Init(*v, kin, index);
+        return { slot, s.generation };
+    }
+    // Same, type picked at run time (one indexed call, see VEHICLE_TYPE_LIST)
+    VehicleHandle Create(VehicleType type, const VehicleState& state);
+
+    // nullptr if the handle is stale (vehicle removed, slot maybe reused)
+    Vehicle* Get(VehicleHandle handle) const;
+    // Dense index (row in the kinematics arrays), -1 if the handle is stale
+    int IndexOf(VehicleHandle handle) const;
+    VehicleHandle HandleAt(size_t denseIndex) const { return { liveSlot[denseIndex], SlotAt(liveSlot[denseIndex]).generation }; }
+
+    void Destroy(VehicleHandle handle);
+    // Reclaims every vehicle flagged 'finished' (call between ticks: dense indices change)
+    // Optionally counts them per type (removedByType: VEHICLE_TYPE_COUNT entries, added to)
+    int RemoveFinished(int* removedByType = nullptr);
+    void Clear();
+
+    // Dense access
+    size_t Count() const { return live.size(); }
+    bool Empty() const { return live.empty(); }
+    Vehicle* operator[](size_t denseIndex) const { return live[denseIndex]; }
+    std::vector<Vehicle*>::const_iterator begin() const { return live.begin(); }
+    std::vector<Vehicle*>::const_iterator end() const { return live.end(); }
+
+    // Rows of one type
+    size_t GroupBegin(VehicleType type) const { return groupStart[type]; }
+    size_t GroupEnd(VehicleType type) const { return groupStart[type + 1]; }
+    size_t CountOf(VehicleType type) const { return GroupEnd(type) - GroupBegin(type); }
+    // Vehicle of type T at a row of its group
+    template <typename T> T& As(size_t denseIndex) const { return *static_cast<T*>(live[denseIndex]); }
+
+    // Hot state (row = dense index)
+    VehicleKinematics& GetKinematics() { return kin; }
+    const VehicleKinematics& GetKinematics() const { return kin; }
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef VEHICLE_RENDERER_H
+#define VEHICLE_RENDERER_H
+
+#include "raylib.h"
+#include "raymath.h"
+#include "vehicle_types.h"
+#include "vehicle_pool.h"
+#include "vehicle_lod.h"
+#include "frustum.h"
+#include <vector>
+
+class ModelManager;
+
+// Instanced drawing of the vehicles: during a frame Add() gathers the pose and color of every
+// vehicle per type and level of detail, Flush() then draws each mesh of a level once for all of them.
+// The color goes to the shader as a per-instance attribute (the shared materials are not
+// touched) and tints what DrawModel used to tint: the meshes on materials[0].
+// Levels (VehicleLodConfig): the model, the model simplified at Load, then a flat box around it;
+// the level each vehicle was drawn at is kept here, by pool slot, for the hysteresis.
+// A type without a model (no ModelManager, or a file that did not load) is drawn as a box.
+// Load / Unload need the window (GL context).
+class VehicleRenderer {
+private:
+    // Vehicles of one type at one level, this frame
+    struct LodBatch {
+        std::vector<Matrix> transforms;  // One per vehicle
+        std::vector<Color> colors;
+        unsigned int colorBuffer = 0;    // GPU copy of 'colors' (instance attribute)
+        int colorCapacity = 0;
+    };
+
+    struct TypeBatch {
+        const Model* model = nullptr;    // Null: drawn as 'box' at every level
+        Matrix base;                     // Model transform, applied before the pose
+        Matrix boxBase;                  // Unit 'box' -> model bounds, then 'base'
+        std::vector<Mesh> reduced;       // VEHICLE_LOD_REDUCED meshes (owned)...
+        std::vector<int> reducedMaterial;// ...and their material in 'model'
+        int triangles[VEHICLE_LOD_COUNT] = {};
+        LodBatch levels[VEHICLE_LOD_COUNT];
+    };
+
+    // Level of the vehicle in a pool slot (a new generation starts again at full detail)
+    struct LodState {
+        unsigned int generation = 0;
+        VehicleLod lod = VEHICLE_LOD_FULL;
+    };
+
+    TypeBatch batches[VEHICLE_TYPE_COUNT];
+    std::vector<LodState> lodStates;   // By VehicleHandle::slot
+    Shader shader = {};
+    int instanceColorLoc = -1;
+    Mesh box = {};                   // Unit cube
+    Material boxMaterial = {};
+    VehicleLodConfig lodConfig;
+    Vector3 eye = { 0.0f, 0.0f, 0.0f };   // This frame's camera
+    bool lodEnabled = false;              // False: full detail (no camera given to Begin)
+    bool loaded = false;
+    int drawCalls = 0;   // Last Flush
+    int lodCounts[VEHICLE_LOD_COUNT] = {};
+
+    void DrawMeshes(LodBatch& level, const Mesh& mesh, const Material& material, bool tinted);
+    LodState& StateOf(VehicleHandle vehicle) {
+        if ((size_t)vehicle.slot >= lodStates.size()) lodStates.resize(vehicle.slot + 1);
+        LodState& state = lodStates[vehicle.slot];
+        if (state.generation != vehicle.generation) {   // Slot reused since the last frame
+            state.generation = vehicle.generation;
+            state.lod = VEHICLE_LOD_FULL;
+        }
+        return state;
+    }
+
+public:
+    VehicleRenderer() {}
+    ~VehicleRenderer() { Unload(); }
+    VehicleRenderer(const VehicleRenderer&) = delete;
+    VehicleRenderer& operator=(const VehicleRenderer&) = delete;
+
+    // False if the instancing shader is not available (the caller draws vehicle by vehicle)
+    bool Load(const ModelManager* models, const VehicleLodConfig& lod = VehicleLodConfig());
+    void Unload();
+    bool IsLoaded() const { return loaded; }
+
+    // Levels are picked by distance to the eye of 'view' (a disabled one: full detail)
+    void Begin(const Frustum& view);
+    // 'pose': vehicle frame -> world (heading, lean, position). Returns the level it is drawn at.
+    VehicleLod Add(VehicleType type, VehicleHandle vehicle, const Matrix& pose, Color color) {
+        VehicleLod level = VEHICLE_LOD_FULL;
+        if (lodEnabled) {
+            LodState& state = StateOf(vehicle);
+            level = state.lod = SelectVehicleLod(state.lod, Vector3Distance(eye, { pose.m12, pose.m13, pose.m14 }), lodConfig);
+        }
+        TypeBatch& batch = batches[type];
+        LodBatch& target = batch.levels[level];
+        target.transforms.push_back(MatrixMultiply(level == VEHICLE_LOD_BOX ? batch.boxBase : batch.base, pose));
+        target.colors.push_back(color);
+        return level;
+    }
+    void Flush();
+
+    int GetDrawCallCount() const { return drawCalls; }
+    int GetLodCount(VehicleLod level) const { return lodCounts[level]; }   // Vehicles per level, last Flush
+    int GetTriangleCount(VehicleType type, VehicleLod level) const { return batches[type].triangles[level]; }
+    const VehicleLodConfig& GetLodConfig() const { return lodConfig; }
+};
+
+#endif
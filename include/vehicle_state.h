@@ -0,0 +1,77 @@
+#ifndef VEHICLE_STATE_H
+#define VEHICLE_STATE_H
+
+#include "raylib.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Hot state of one vehicle (one row of VehicleKinematics).
+// Used to create a vehicle and to read one back, the simulation works on the arrays.
+struct VehicleState {
+    Vector3 position = {0,0,0};
+    Vector3 forward = {1,0,0};
+    float speed = 5.0f;
+    float desiredSpeed = 5.0f;
+    float length = 4.0f;
+    int targetNodeId = -1;
+    int currentNodeId = -1;   // Node we are leaving: the vehicle drives on edge currentNodeId -> targetNodeId
+    double forceMoveUntil = -1.0; // Sim time until which obstacles are ignored (set by a click)
+    bool finished = false;
+    uint32_t routeSeed = 1;   // State of the vehicle's own generator (turn / destination choices), see SimRandom
+    int routeId = -1;         // Route followed (RouteTable), -1 = random turns
+    float edgeTime = 0.0f;    // Seconds on the current edge, < 0 once reported (see Vehicle::Arrive)
+    int doneEdge = -1;        // Edge just driven to its end, -1 = none (collected by TravelTimes)
+    float doneTime = 0.0f;    // Seconds it took
+};
+
+// Hot per-vehicle state, one contiguous array per field (index = dense index in VehiclePool).
+// The per-tick loops only stream through the arrays they need; colors, model names
+// and the per-type behaviour stay in the (cold) Vehicle objects.
+struct VehicleKinematics {
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> fwdX, fwdZ;           // Heading on the XZ plane (vehicles drive flat)
+    std::vector<float> speed;
+    std::vector<float> desiredSpeed;
+    std::vector<float> length;
+    std::vector<int> targetNodeId;
+    std::vector<int> currentNodeId;
+    std::vector<double> forceMoveUntil;
+    std::vector<unsigned char> finished;
+    std::vector<uint32_t> routeSeed;
+    std::vector<int> routeId;
+    std::vector<float> edgeTime;
+    std::vector<int> doneEdge;
+    std::vector<float> doneTime;
+    std::vector<float> prevX, prevY, prevZ;   // Pose at the previous tick (render interpolation)
+    std::vector<float> prevFwdX, prevFwdZ;
+
+    size_t Size() const { return posX.size(); }
+
+    Vector3 Position(size_t i) const { return { posX[i], posY[i], posZ[i] }; }
+    Vector3 Forward(size_t i) const { return { fwdX[i], 0.0f, fwdZ[i] }; }
+    void SetPosition(size_t i, Vector3 p) { posX[i] = p.x; posY[i] = p.y; posZ[i] = p.z; }
+    void SetForward(size_t i, Vector3 f) { fwdX[i] = f.x; fwdZ[i] = f.z; }
+
+    // Copies the current pose of every vehicle to prev* (start of a tick)
+    void SavePreviousPose();
+    void SavePreviousPose(size_t begin, size_t end);   // Rows [begin, end) only
+    // Pose between the previous tick (alpha = 0) and the current one (alpha = 1)
+    Vector3 InterpolatedPosition(size_t i, float alpha) const;
+    Vector3 InterpolatedForward(size_t i, float alpha) const;
+    // No interpolation across a jump (teleport): the previous pose becomes the current one
+    void SnapPreviousPose(size_t i);
+
+    VehicleState GetRow(size_t i) const;
+    void PushBack(const VehicleState& s);
+    void MoveRow(size_t from, size_t to);   // Overwrites row 'to' (swap-and-pop helper)
+    void SwapRows(size_t a, size_t b);
+    void PopBack();
+    void Reserve(size_t capacity);
+    void Clear();
+
+    // Hot bytes stored per vehicle (all arrays together)
+    static size_t BytesPerVehicle();
+};
+
+#endif
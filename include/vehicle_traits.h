@@ -0,0 +1,69 @@
+#ifndef VEHICLE_TRAITS_H
+#define VEHICLE_TRAITS_H
+
+#include <cstddef>
+#include <cmath>
+#include "vehicle.h"
+#include "vehicle_types.h"
+
+// Per-type behaviour, resolved at compile time (the per-type constants are in the registry,
+// vehicle_types.h). VehiclePool keeps the vehicles grouped by type (one contiguous range of
+// rows per type), so the per-type code runs in one loop per group where T is known: no
+// virtual call, and the behaviour of each type is inlined into its own loop.
+
+template <typename T> struct VehicleTag { typedef T type; };
+
+// f(VehicleTag<T>()) for every type, in registry order
+template <typename F> void ForEachVehicleType(F&& f) {
+#define X(ID, CLASS, ...) f(VehicleTag<CLASS>());
+    VEHICLE_TYPE_LIST(X)
+#undef X
+}
+
+// =============================================================================
+//  TRAITS
+// =============================================================================
+
+// Defaults: no behaviour of its own (a type's traits hide what they redefine)
+template <typename T>
+struct PlainVehicleTraits {
+    static constexpr VehicleType TYPE = VehicleTypeOf<T>::value;
+    static const VehicleTypeInfo& Info() { return GetVehicleTypeInfo(TYPE); }
+
+    // New vehicle, its row already in the kinematics arrays
+    static void Init(T&, const VehicleKinematics&, size_t) {}
+    // Once per tick, after the vehicles moved (only for ANIMATED types: the others are not looped over)
+    static constexpr bool ANIMATED = false;
+    static void Animate(T&, const VehicleKinematics&, size_t, float) {}
+};
+template <typename T> constexpr VehicleType PlainVehicleTraits<T>::TYPE;
+template <typename T> constexpr bool PlainVehicleTraits<T>::ANIMATED;
+
+template <typename T> struct VehicleTraits : PlainVehicleTraits<T> {};
+
+template <> struct VehicleTraits<Motorcycle> : PlainVehicleTraits<Motorcycle> {
+    static constexpr bool ANIMATED = true;
+    static constexpr float MAX_TILT = 25.0f;     // Degrés
+    static constexpr float TILT_RESPONSE = 8.0f; // 1/s, lissage de l'inclinaison
+
+    static void Init(Motorcycle& moto, const VehicleKinematics& k, size_t i) {
+        moto.lastForwardX = k.fwdX[i];
+        moto.lastForwardZ = k.fwdZ[i];
+    }
+
+    // Inclinaison dans les virages : tan(angle) = vitesse * vitesse de lacet / g,
+    // lacet mesuré sur le changement de direction depuis le tick précédent
+    static void Animate(Motorcycle& moto, const VehicleKinematics& k, size_t i, float dt) {
+        if (dt <= 0.0f) return;
+        float yawRate = (moto.lastForwardZ * k.fwdX[i] - moto.lastForwardX * k.fwdZ[i]) / dt;
+        float target = -atanf(k.speed[i] * yawRate / 9.81f) * RAD2DEG;
+        if (target > MAX_TILT) target = MAX_TILT;
+        if (target < -MAX_TILT) target = -MAX_TILT;
+        float blend = dt * TILT_RESPONSE < 1.0f ? dt * TILT_RESPONSE : 1.0f;
+        moto.tiltAngle += (target - moto.tiltAngle) * blend;
+        moto.lastForwardX = k.fwdX[i];
+        moto.lastForwardZ = k.fwdZ[i];
+    }
+};
+
+#endif
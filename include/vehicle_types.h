@@ -0,0 +1,48 @@
+#ifndef VEHICLE_TYPES_H
+#define VEHICLE_TYPES_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <string>
+
+// Registry of the vehicle types: one line per type, everything else is generated from it
+// (enum, names, model files, spawn table, pool groups, per-type statistics).
+//   X(ID, Class, Name, Model file, Speed (m/s), Length (m), Color r, g, b, a)
+// Name is the key of scenario files and menus. Class is declared in vehicle.h; a type with a
+// behaviour of its own also specializes VehicleTraits<Class> (vehicle_traits.h).
+#define VEHICLE_TYPE_LIST(X) \
+    X(CAR,        Car,        "Car",        "assets/models/car.glb",    15.0f,  4.5f,   0, 121, 241, 255) /* Model: 6.27 m */  \
+    X(BUS,        Bus,        "Bus",        "assets/models/bus.glb",    10.0f,  8.5f, 255, 203,   0, 255) /* Model: 11.80 m */ \
+    X(TRUCK,      Truck,      "Truck",      "assets/models/truck.glb",   8.0f, 10.0f, 139,  69,  19, 255) /* Model: 14.50 m */ \
+    X(TAXI,       Taxi,       "Taxi",       "assets/models/taxi.glb",   18.0f,  4.5f, 253, 249,   0, 255) /* Model: 7.09 m */  \
+    X(POLICE,     PoliceCar,  "Police",     "assets/models/police.glb", 22.0f,  4.5f,  20,  20, 120, 255) /* Model: 6.96 m */  \
+    X(MOTORCYCLE, Motorcycle, "Motorcycle", "assets/models/moto.glb",   20.0f,  2.5f,  50,  50,  50, 255) /* Model: 3.60 m */
+
+enum VehicleType : uint8_t {
+#define X(ID, ...) VEHICLE_##ID,
+    VEHICLE_TYPE_LIST(X)
+#undef X
+    VEHICLE_TYPE_COUNT
+};
+
+struct VehicleTypeInfo {
+    const char* name;
+    const char* modelFile;
+    float speed;     // Desired speed of new vehicles
+    float length;
+    Color color;
+};
+
+static constexpr VehicleTypeInfo VEHICLE_TYPE_INFO[VEHICLE_TYPE_COUNT] = {
+#define X(ID, CLASS, NAME, MODEL, SPEED, LENGTH, R, G, B, A) { NAME, MODEL, SPEED, LENGTH, { R, G, B, A } },
+    VEHICLE_TYPE_LIST(X)
+#undef X
+};
+
+inline const VehicleTypeInfo& GetVehicleTypeInfo(VehicleType type) { return VEHICLE_TYPE_INFO[type]; }
+inline const char* GetVehicleTypeName(VehicleType type) { return VEHICLE_TYPE_INFO[type].name; }
+
+// Name -> type (configuration / scenario parsing only), false if unknown
+bool FindVehicleType(const std::string& name, VehicleType& type);
+
+#endif
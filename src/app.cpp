@@ -39,6 +39,7 @@ App::App() {
     gameStarted = false;
     loadingTimer = 0.0f;
     showDebugNodes = true;
+    lastFrameClock = GetTime();
 }
 
 App::~App() { //.-.
@@ -50,7 +51,9 @@ void App::Run() {
     // The Main Loop
     while (!WindowShouldClose()) {
         Update();
-        Draw();
+        // In turbo a frame that fell behind is spent on ticks only (input still polled)
+        if (!interface.IsInSimulation() || simulation.ShouldRender()) Draw();
+        else PollInputEvents();
         
         // Check if the exit button was pressed in the menu
         if (interface.shouldExit) break; 
@@ -58,6 +61,10 @@ void App::Run() {
 }
 
 void App::Update() {
+    double now = GetTime();
+    float wallDt = (float)(now - lastFrameClock);
+    lastFrameClock = now;
+
     interface.Update();
 
     // Transition Logic: Menu -> Loading -> Game
@@ -90,6 +97,11 @@ void App::Update() {
         // [N] Toggle Debug Nodes
         if (IsKeyPressed(KEY_N)) showDebugNodes = !showDebugNodes;
 
+        // [T] Cycle Turbo (off -> 10x -> ... -> 1000x -> off)
+        if (IsKeyPressed(KEY_T)) {
+            globalConfig.turboMultiplier = (globalConfig.turboMultiplier >= 1000) ? 0 : NextTurboLevel(globalConfig.turboMultiplier, 1);
+        }
+
         // Camera Controls (only if not paused) //.-.
         if (!pauseMenu.isVisible) {
             // Define settings
@@ -110,8 +122,9 @@ void App::Update() {
 
         // Simulation Update
         if (interface.IsInSimulation()) {
-            float dt = GetFrameTime() * globalConfig.simulationSpeed;
-            simulation.Update(dt, camera);
+            // Frame time clamped: a hitch drops time instead of forcing a burst of ticks
+            float frameTime = std::min(wallDt, (float)SimulationConfig::MAX_FRAME_TIME);
+            simulation.Update(frameTime, globalConfig.GetEffectiveSpeed(), camera);
         }
     }
 }
@@ -123,7 +136,7 @@ void App::Draw() {
         if (interface.IsInSimulation() || interface.GetState() == STATE_PAUSED) {
             // 1. Draw 3D World
             BeginMode3D(camera);
-                simulation.Draw3D(showDebugNodes); // No camera needed here
+                simulation.Draw3D(showDebugNodes, camera); // Camera for the culling
             EndMode3D();
 
             // 2. Draw Overlays (IDs, HUD, Menus)
@@ -137,7 +150,13 @@ void App::Draw() {
                 DrawText("- [N] : Show Nodes", 10, 85, 20, DARKGRAY);
                 DrawText("- [WASD] : Move Camera", 10, 110, 20, DARKGRAY);
                 DrawText("- Click Car : Force Move", 10, 135, 20, DARKGRAY);
-                DrawText(TextFormat("- Vehicles: %d", simulation.GetVehicleCount()), 10, 160, 20, DARKGRAY);
+                DrawText("- [T] : Turbo", 10, 160, 20, DARKGRAY);
+                DrawText(TextFormat("- Vehicles: %d", simulation.GetVehicleCount()), 10, 185, 20, DARKGRAY);
+
+                // Asked speed vs what the CPU actually delivers (sim-seconds per wall-second)
+                const SimPacer& pacer = simulation.GetPacer();
+                DrawText(TextFormat("- Speed: %.1fx (achieved %.1f sim-s/s)", globalConfig.GetEffectiveSpeed(), pacer.GetAchievedRate()),
+                         10, 210, 20, pacer.IsBehind() ? MAROON : DARKGRAY);
             }
 
             // In-Game Menu
@@ -0,0 +1,159 @@
+#include "city_buildings.h"
+#include "city_structures.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+// The fountain is round: same signature as the others, the rotation is ignored
+static void AddFountainAt(MeshBuilder& mesh, Vector3 position, float) {
+    AddFountain(mesh, position);
+}
+
+typedef void (*BuildingBuilder)(MeshBuilder& mesh, Vector3 position, float rotationAngle);
+
+struct BuildingTypeInfo {
+    const char* name;
+    BuildingBuilder build;
+};
+
+static const BuildingTypeInfo BUILDING_TYPE_INFO[BUILDING_TYPE_COUNT] = {
+#define X(ID, NAME, BUILDER) { NAME, BUILDER },
+    BUILDING_TYPE_LIST(X)
+#undef X
+};
+
+const char* GetBuildingTypeName(BuildingType type) {
+    return BUILDING_TYPE_INFO[type].name;
+}
+
+void AddBuilding(MeshBuilder& mesh, BuildingType type, Vector3 position, float rotation) {
+    BUILDING_TYPE_INFO[type].build(mesh, position, rotation);
+}
+
+Matrix GetPlacementTransform(const BuildingPlacement& placement) {
+    Matrix turn = MatrixRotate({ 0.0f, 1.0f, 0.0f }, placement.rotation * DEG2RAD);
+    Matrix move = MatrixTranslate(placement.position.x, placement.position.y, placement.position.z);
+    return MatrixMultiply(turn, move);
+}
+
+// --- Instancing shader: vertex colors (no lighting, like the default shader), model matrix per instance ---
+#if defined(PLATFORM_DESKTOP)
+static const char* INSTANCING_VS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec4 vertexColor;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragColor = vertexColor;\n"
+    "    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+static const char* INSTANCING_FS =
+    "#version 330\n"
+    "in vec4 fragColor;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    finalColor = fragColor * colDiffuse;\n"
+    "}\n";
+#else   // OpenGL ES 2 / WebGL
+static const char* INSTANCING_VS =
+    "#version 100\n"
+    "attribute vec3 vertexPosition;\n"
+    "attribute vec4 vertexColor;\n"
+    "attribute mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "varying vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragColor = vertexColor;\n"
+    "    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+static const char* INSTANCING_FS =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec4 fragColor;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main() {\n"
+    "    gl_FragColor = fragColor * colDiffuse;\n"
+    "}\n";
+#endif
+
+// --- CityBuildings ---
+
+void CityBuildings::Load(const std::vector<BuildingPlacement>& placements) {
+    Unload();
+
+    MeshBuilder prototype;
+    for (int t = 0; t < BUILDING_TYPE_COUNT; t++) {
+        for (const BuildingPlacement& placement : placements) {
+            if (placement.type == t) transforms[t].push_back(GetPlacementTransform(placement));
+        }
+        if (transforms[t].empty()) continue;
+
+        // Outlines are baked with the body (thin quads): instanced like it, never replayed per placement
+        prototype.Clear();
+        AddBuilding(prototype, (BuildingType)t, { 0.0f, 0.0f, 0.0f }, 0.0f);
+        prototypes[t].Load(prototype);
+        for (const Matrix& transform : transforms[t]) {
+            placedBounds[t].push_back(TransformBox(prototypes[t].GetBounds(), transform));
+        }
+        triangleCount += prototypes[t].GetTriangleCount();
+        placedTriangleCount += prototypes[t].GetTriangleCount() * (int)transforms[t].size();
+        outlineCount += prototype.GetLineCount();
+    }
+
+    // A shader that does not compile comes back as the default one: draw the copies one by one
+    Shader shader = LoadShaderFromMemory(INSTANCING_VS, INSTANCING_FS);
+    instanced = shader.id != rlGetShaderIdDefault();
+    if (instanced) {
+        shader.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(shader, "mvp");
+        shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(shader, "instanceTransform");
+        instancing = LoadMaterialDefault();
+        instancing.shader = shader;
+    }
+    loaded = true;
+}
+
+void CityBuildings::Unload() {
+    if (!loaded) return;
+    for (int t = 0; t < BUILDING_TYPE_COUNT; t++) {
+        prototypes[t].Unload();
+        transforms[t].clear();
+        placedBounds[t].clear();
+    }
+    if (instanced) UnloadMaterial(instancing);   // Also unloads its shader
+    instancing = Material();
+    instanced = false;
+    triangleCount = 0;
+    placedTriangleCount = 0;
+    outlineCount = 0;
+    drawnCount = 0;
+    loaded = false;
+}
+
+void CityBuildings::Draw(const Frustum& view) {
+    drawnCount = 0;
+    if (!loaded) return;
+    for (int t = 0; t < BUILDING_TYPE_COUNT; t++) {
+        visible.clear();
+        for (size_t i = 0; i < transforms[t].size(); i++) {
+            if (view.IntersectsBox(placedBounds[t][i])) visible.push_back(transforms[t][i]);
+        }
+        prototypes[t].DrawInstanced(visible, instancing, instanced);
+        drawnCount += (int)visible.size();
+    }
+}
+
+int CityBuildings::GetPrototypeCount() const {
+    int count = 0;
+    for (int t = 0; t < BUILDING_TYPE_COUNT; t++) {
+        if (prototypes[t].IsLoaded()) count++;
+    }
+    return count;
+}
+
+int CityBuildings::GetInstanceCount() const {
+    int count = 0;
+    for (int t = 0; t < BUILDING_TYPE_COUNT; t++) count += (int)transforms[t].size();
+    return count;
+}
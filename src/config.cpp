@@ -3,6 +3,18 @@
 // Define the global config
 SimulationConfig globalConfig;
 
+static const int TURBO_LEVELS[] = {0, 10, 30, 100, 300, 1000};
+static const int TURBO_LEVEL_COUNT = sizeof(TURBO_LEVELS) / sizeof(TURBO_LEVELS[0]);
+
+int NextTurboLevel(int current, int direction) {
+    int index = 0;
+    while (index + 1 < TURBO_LEVEL_COUNT && TURBO_LEVELS[index + 1] <= current) index++;
+    index += (direction > 0) ? 1 : -1;
+    if (index < 0) index = 0;
+    if (index >= TURBO_LEVEL_COUNT) index = TURBO_LEVEL_COUNT - 1;
+    return TURBO_LEVELS[index];
+}
+
 SimulationConfig GetDefaultConfig() {
     SimulationConfig cfg;
     
@@ -15,42 +27,42 @@ SimulationConfig GetDefaultConfig() {
 
     // 1. CARS
     VehicleSpawnConfig car;
-    car.type = "Car";
+    car.type = VEHICLE_CAR;
     car.count = 8;
     car.startNodes = validStartNodes;
     cfg.vehicleConfigs.push_back(car);
 
     // 2. BUSES
     VehicleSpawnConfig bus;
-    bus.type = "Bus";
+    bus.type = VEHICLE_BUS;
     bus.count = 3;
     bus.startNodes = validStartNodes;
     cfg.vehicleConfigs.push_back(bus);
 
     // 3. TRUCKS
     VehicleSpawnConfig truck;
-    truck.type = "Truck";
+    truck.type = VEHICLE_TRUCK;
     truck.count = 3;
     truck.startNodes = validStartNodes;
     cfg.vehicleConfigs.push_back(truck);
 
     // 4. TAXIS
     VehicleSpawnConfig taxi;
-    taxi.type = "Taxi";
+    taxi.type = VEHICLE_TAXI;
     taxi.count = 5;
     taxi.startNodes = validStartNodes;
     cfg.vehicleConfigs.push_back(taxi);
 
     // 5. POLICE
     VehicleSpawnConfig police;
-    police.type = "Police";
+    police.type = VEHICLE_POLICE;
     police.count = 2;
     police.startNodes = validStartNodes;
     cfg.vehicleConfigs.push_back(police);
 
     // 6. MOTORCYCLES
     VehicleSpawnConfig moto;
-    moto.type = "Motorcycle";
+    moto.type = VEHICLE_MOTORCYCLE;
     moto.count = 4;
     moto.startNodes = validStartNodes;
     cfg.vehicleConfigs.push_back(moto);
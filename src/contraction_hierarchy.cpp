@@ -0,0 +1,425 @@
+#include "contraction_hierarchy.h"
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstring>
+
+typedef std::pair<float, int> QueueEntry; // (cost, node), smallest cost first
+typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> MinQueue;
+
+static const float CH_UNREACHABLE = 1.0e30f;
+// Witness searches stop after this many nodes: a missed witness only costs an extra shortcut
+static const int WITNESS_SETTLE_LIMIT = 200;
+static const char CH_FILE_MAGIC[4] = { 'R', 'C', 'H', '1' };
+
+// =============================================================================
+//  BUILD (contraction)
+// =============================================================================
+
+namespace {
+
+// Edges of the graph being contracted: only between nodes that are still there
+struct BuildEdge {
+    int other;
+    float cost;
+    int middle;
+};
+
+// Keeps the cheapest of parallel edges
+void AddOrImprove(std::vector<BuildEdge>& list, int other, float cost, int middle) {
+    for (BuildEdge& e : list) {
+        if (e.other == other) {
+            if (cost < e.cost) {
+                e.cost = cost;
+                e.middle = middle;
+            }
+            return;
+        }
+    }
+    list.push_back({ other, cost, middle });
+}
+
+void RemoveEdgeTo(std::vector<BuildEdge>& list, int other) {
+    for (size_t k = 0; k < list.size(); k++) {
+        if (list[k].other == other) {
+            list[k] = list.back();
+            list.pop_back();
+            return;
+        }
+    }
+}
+
+struct Contractor {
+    std::vector<std::vector<BuildEdge>> out, in;
+    std::vector<unsigned char> contracted;
+    std::vector<int> contractedNeighbours;
+
+    // Witness search scratch (stamped, never cleared)
+    std::vector<float> dist;
+    std::vector<uint32_t> distStamp;
+    uint32_t stamp = 0;
+
+    float DistanceTo(int node) const { return distStamp[node] == stamp ? dist[node] : CH_UNREACHABLE; }
+
+    std::vector<uint32_t> targetStamp;   // Nodes the witness search is looking for
+
+    // Dijkstra from 'source' without going through 'skip', up to 'limit' or until the
+    // 'targets' nodes marked for this search (targetStamp == stamp + 1) are settled
+    void Witness(int source, int skip, float limit, int targets) {
+        stamp++;
+        MinQueue open;
+        dist[source] = 0.0f;
+        distStamp[source] = stamp;
+        open.push({ 0.0f, source });
+        int settled = 0;
+        while (!open.empty() && settled < WITNESS_SETTLE_LIMIT && targets > 0) {
+            QueueEntry top = open.top();
+            open.pop();
+            int node = top.second;
+            if (top.first > DistanceTo(node)) continue; // Stale entry
+            if (top.first > limit) break;
+            settled++;
+            if (targetStamp[node] == stamp) targets--;
+            for (const BuildEdge& e : out[node]) {
+                if (e.other == skip) continue;
+                float c = top.first + e.cost;
+                if (c < DistanceTo(e.other)) {
+                    dist[e.other] = c;
+                    distStamp[e.other] = stamp;
+                    open.push({ c, e.other });
+                }
+            }
+        }
+    }
+
+    // Shortcuts needed to contract v: counted only, or added when 'apply'
+    int Shortcuts(int v, bool apply) {
+        int count = 0;
+        // Shortcuts only touch the lists of v's neighbours, never v's own lists
+        for (const BuildEdge& inEdge : in[v]) {
+            int u = inEdge.other;
+            float limit = -1.0f;
+            int targets = 0;
+            for (const BuildEdge& outEdge : out[v]) {
+                if (outEdge.other == u) continue;
+                limit = std::max(limit, inEdge.cost + outEdge.cost);
+                targetStamp[outEdge.other] = stamp + 1;
+                targets++;
+            }
+            if (targets == 0) continue; // u -> v -> u only
+            Witness(u, v, limit, targets);
+            for (const BuildEdge& outEdge : out[v]) {
+                int w = outEdge.other;
+                if (w == u) continue;
+                float via = inEdge.cost + outEdge.cost;
+                if (DistanceTo(w) <= via) continue; // Witness path: no shortcut
+                count++;
+                if (apply) {
+                    AddOrImprove(out[u], w, via, v);
+                    AddOrImprove(in[w], u, via, v);
+                }
+            }
+        }
+        return count;
+    }
+
+    std::vector<int> level;   // Depth in the hierarchy so far (keeps it balanced)
+
+    int Priority(int v) {
+        int degree = (int)(in[v].size() + out[v].size());
+        // Edge difference first; contracted neighbours and depth spread the contraction over the map
+        return 2 * (Shortcuts(v, false) - degree) + contractedNeighbours[v] + level[v];
+    }
+};
+
+} // namespace
+
+void ContractionHierarchy::Build(const RoadGraph& graph, const std::vector<float>& costs) {
+    int n = graph.GetNodeCount();
+    nodeCount = n;
+    graphEdgeCount = graph.GetEdgeCount();
+
+    Contractor c;
+    c.out.assign(n, std::vector<BuildEdge>());
+    c.in.assign(n, std::vector<BuildEdge>());
+    c.contracted.assign(n, 0);
+    c.contractedNeighbours.assign(n, 0);
+    c.level.assign(n, 0);
+    c.dist.assign(n, CH_UNREACHABLE);
+    c.distStamp.assign(n, 0);
+    c.targetStamp.assign(n, 0);
+    for (int from = 0; from < n; from++) {
+        if (graph.TypeOf(from) == TELEPORT) continue; // Vehicles jump away from here
+        int e = graph.FirstEdge(from);
+        for (int to : graph.Successors(from)) {
+            float cost = costs[e++];
+            if (to == from) continue;
+            AddOrImprove(c.out[from], to, cost, -1);
+            AddOrImprove(c.in[to], from, cost, -1);
+        }
+    }
+
+    // Node order: lowest priority first, priorities refreshed lazily when popped
+    typedef std::pair<int, int> OrderEntry; // (priority, node)
+    std::priority_queue<OrderEntry, std::vector<OrderEntry>, std::greater<OrderEntry>> order;
+    for (int v = 0; v < n; v++) order.push({ c.Priority(v), v });
+
+    rank.assign(n, 0);
+    std::vector<std::vector<Edge>> upLists(n), downLists(n);
+    int nextRank = 0;
+    while (!order.empty()) {
+        int v = order.top().second;
+        order.pop();
+        if (c.contracted[v]) continue;
+        int priority = c.Priority(v);
+        if (!order.empty() && priority > order.top().first) {
+            order.push({ priority, v }); // Not the least important any more
+            continue;
+        }
+
+        c.Shortcuts(v, true);
+        // Every edge still attached to v goes to a node contracted later: v's upward edges
+        std::vector<int> neighbours;
+        for (const BuildEdge& e : c.out[v]) {
+            upLists[v].push_back({ e.other, e.cost, e.middle });
+            RemoveEdgeTo(c.in[e.other], v);
+            neighbours.push_back(e.other);
+        }
+        for (const BuildEdge& e : c.in[v]) {
+            downLists[v].push_back({ e.other, e.cost, e.middle });
+            RemoveEdgeTo(c.out[e.other], v);
+            neighbours.push_back(e.other);
+        }
+        std::vector<BuildEdge>().swap(c.out[v]);
+        std::vector<BuildEdge>().swap(c.in[v]);
+        c.contracted[v] = 1;
+        rank[v] = nextRank++;
+
+        // Their priorities change, refreshed when they come up (re-simulating every neighbour
+        // right away gives a slightly better order for a much slower build)
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (int w : neighbours) {
+            c.contractedNeighbours[w]++;
+            c.level[w] = std::max(c.level[w], c.level[v] + 1);
+        }
+    }
+
+    // Flatten to CSR
+    upOffsets.assign(n + 1, 0);
+    downOffsets.assign(n + 1, 0);
+    up.clear();
+    down.clear();
+    for (int v = 0; v < n; v++) {
+        up.insert(up.end(), upLists[v].begin(), upLists[v].end());
+        down.insert(down.end(), downLists[v].begin(), downLists[v].end());
+        upOffsets[v + 1] = (int)up.size();
+        downOffsets[v + 1] = (int)down.size();
+    }
+}
+
+size_t ContractionHierarchy::GetShortcutCount() const {
+    size_t count = 0;
+    for (const Edge& e : up) count += e.middle >= 0;
+    for (const Edge& e : down) count += e.middle >= 0;
+    return count;
+}
+
+// =============================================================================
+//  PATH UNPACKING
+// =============================================================================
+
+const ContractionHierarchy::Edge* ContractionHierarchy::FindUp(int from, int to) const {
+    for (int k = upOffsets[from]; k < upOffsets[from + 1]; k++) {
+        if (up[k].to == to) return &up[k];
+    }
+    return nullptr;
+}
+
+const ContractionHierarchy::Edge* ContractionHierarchy::FindDown(int to, int from) const {
+    for (int k = downOffsets[to]; k < downOffsets[to + 1]; k++) {
+        if (down[k].to == from) return &down[k];
+    }
+    return nullptr;
+}
+
+void ContractionHierarchy::Unpack(int from, int to, int middle, std::vector<int>& path) const {
+    if (middle < 0) {
+        path.push_back(to);
+        return;
+    }
+    // The middle node was contracted before both ends: both halves are stored on it
+    const Edge* first = FindDown(middle, from);
+    const Edge* second = FindUp(middle, to);
+    Unpack(from, middle, first->middle, path);
+    Unpack(middle, to, second->middle, path);
+}
+
+// =============================================================================
+//  SERIALIZATION
+// =============================================================================
+
+namespace {
+
+template <typename T> void WriteVector(std::ostream& out, const std::vector<T>& values) {
+    uint32_t count = (uint32_t)values.size();
+    out.write((const char*)&count, sizeof(count));
+    if (count) out.write((const char*)values.data(), sizeof(T) * count);
+}
+
+template <typename T> void ReadVector(std::istream& in, std::vector<T>& values, uint32_t maxCount) {
+    uint32_t count = 0;
+    in.read((char*)&count, sizeof(count));
+    if (!in || count > maxCount) throw std::runtime_error("ContractionHierarchy: truncated or corrupt file");
+    values.resize(count);
+    if (count) in.read((char*)values.data(), sizeof(T) * count);
+    if (!in) throw std::runtime_error("ContractionHierarchy: truncated file");
+}
+
+} // namespace
+
+void ContractionHierarchy::Save(std::ostream& out) const {
+    out.write(CH_FILE_MAGIC, sizeof(CH_FILE_MAGIC));
+    int32_t counts[2] = { nodeCount, graphEdgeCount };
+    out.write((const char*)counts, sizeof(counts));
+    WriteVector(out, rank);
+    WriteVector(out, upOffsets);
+    WriteVector(out, up);
+    WriteVector(out, downOffsets);
+    WriteVector(out, down);
+}
+
+void ContractionHierarchy::Load(std::istream& in, const RoadGraph& graph) {
+    char magic[sizeof(CH_FILE_MAGIC)];
+    int32_t counts[2] = { 0, 0 };
+    in.read(magic, sizeof(magic));
+    in.read((char*)counts, sizeof(counts));
+    if (!in || std::memcmp(magic, CH_FILE_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("ContractionHierarchy: not a hierarchy file");
+    }
+    if (counts[0] != graph.GetNodeCount() || counts[1] != graph.GetEdgeCount()) {
+        throw std::runtime_error("ContractionHierarchy: file built for another graph");
+    }
+
+    ContractionHierarchy loaded;
+    loaded.nodeCount = counts[0];
+    loaded.graphEdgeCount = counts[1];
+    uint32_t n = (uint32_t)counts[0];
+    ReadVector(in, loaded.rank, n);
+    ReadVector(in, loaded.upOffsets, n + 1);
+    ReadVector(in, loaded.up, UINT32_MAX);
+    ReadVector(in, loaded.downOffsets, n + 1);
+    ReadVector(in, loaded.down, UINT32_MAX);
+
+    // Checked once here so a query never reads out of bounds
+    bool valid = loaded.rank.size() == n && loaded.upOffsets.size() == n + 1 && loaded.downOffsets.size() == n + 1 &&
+                 loaded.upOffsets[0] == 0 && loaded.downOffsets[0] == 0 &&
+                 loaded.upOffsets[n] == (int)loaded.up.size() && loaded.downOffsets[n] == (int)loaded.down.size();
+    for (uint32_t v = 0; valid && v < n; v++) {
+        valid = loaded.upOffsets[v] <= loaded.upOffsets[v + 1] && loaded.downOffsets[v] <= loaded.downOffsets[v + 1];
+    }
+    for (const std::vector<Edge>* edges : { &loaded.up, &loaded.down }) {
+        for (size_t k = 0; valid && k < edges->size(); k++) {
+            const Edge& e = (*edges)[k];
+            valid = e.to >= 0 && e.to < (int)n && e.middle < (int)n && e.cost >= 0.0f;
+        }
+    }
+    if (!valid) throw std::runtime_error("ContractionHierarchy: corrupt file");
+    *this = std::move(loaded);
+}
+
+// =============================================================================
+//  QUERIES
+// =============================================================================
+
+ChQuery::ChQuery(const ContractionHierarchy& hierarchy)
+    : ch(&hierarchy),
+      forward(hierarchy.GetNodeCount(), Label{ CH_UNREACHABLE, -1, -1, 0 }),
+      backward(hierarchy.GetNodeCount(), Label{ CH_UNREACHABLE, -1, -1, 0 }) {}
+
+bool ChQuery::FindRoute(int origin, int destination, float* cost, std::vector<int>* path) {
+    if (path) path->clear();
+    settledCount = 0;
+    if (++stamp == 0) { // Wrapped: forget every old label once
+        for (Label& l : forward) l.stamp = 0;
+        for (Label& l : backward) l.stamp = 0;
+        stamp = 1;
+    }
+    auto costOf = [this](const std::vector<Label>& labels, int node) {
+        return labels[node].stamp == stamp ? labels[node].cost : CH_UNREACHABLE;
+    };
+
+    MinQueue open[2];
+    forward[origin] = { 0.0f, -1, -1, stamp };
+    backward[destination] = { 0.0f, -1, -1, stamp };
+    open[0].push({ 0.0f, origin });
+    open[1].push({ 0.0f, destination });
+    float best = CH_UNREACHABLE;
+    int meet = -1;
+
+    while (true) {
+        // Stop a direction once it cannot improve the best meeting point
+        for (int side = 0; side < 2; side++) {
+            if (!open[side].empty() && open[side].top().first >= best) open[side] = MinQueue();
+        }
+        if (open[0].empty() && open[1].empty()) break;
+        int side = open[1].empty() || (!open[0].empty() && open[0].top().first <= open[1].top().first) ? 0 : 1;
+
+        std::vector<Label>& mine = side == 0 ? forward : backward;
+        const std::vector<Label>& other = side == 0 ? backward : forward;
+        // Forward goes up along 'up' edges; backward goes up along 'down' edges (stored reversed)
+        const std::vector<int>& offsets = side == 0 ? ch->upOffsets : ch->downOffsets;
+        const std::vector<ContractionHierarchy::Edge>& edges = side == 0 ? ch->up : ch->down;
+        const std::vector<int>& stallOffsets = side == 0 ? ch->downOffsets : ch->upOffsets;
+        const std::vector<ContractionHierarchy::Edge>& stallEdges = side == 0 ? ch->down : ch->up;
+
+        QueueEntry top = open[side].top();
+        open[side].pop();
+        int node = top.second;
+        if (top.first > costOf(mine, node)) continue; // Stale entry
+        settledCount++;
+
+        float through = top.first + costOf(other, node);
+        if (through < best) {
+            best = through;
+            meet = node;
+        }
+
+        // Stall on demand: a higher node already reached reaches this one cheaper, so this
+        // label is not on a shortest path and nothing is relaxed from it
+        bool stalled = false;
+        for (int k = stallOffsets[node]; k < stallOffsets[node + 1] && !stalled; k++) {
+            stalled = costOf(mine, stallEdges[k].to) + stallEdges[k].cost < top.first;
+        }
+        if (stalled) continue;
+
+        for (int k = offsets[node]; k < offsets[node + 1]; k++) {
+            const ContractionHierarchy::Edge& e = edges[k];
+            float c = top.first + e.cost;
+            if (c < costOf(mine, e.to)) {
+                mine[e.to] = { c, node, e.middle, stamp };
+                open[side].push({ c, e.to });
+            }
+        }
+    }
+
+    if (meet < 0) return false;
+    if (cost) *cost = best;
+    if (path) {
+        // origin ... meet: the forward labels, read backwards
+        std::vector<int> upward;
+        for (int node = meet; node >= 0; node = forward[node].parent) upward.push_back(node);
+        path->push_back(origin);
+        for (size_t k = upward.size() - 1; k > 0; k--) {
+            ch->Unpack(upward[k], upward[k - 1], forward[upward[k - 1]].middle, *path);
+        }
+        // meet ... destination: the backward labels point towards the destination
+        for (int node = meet; backward[node].parent >= 0; node = backward[node].parent) {
+            ch->Unpack(node, backward[node].parent, backward[node].middle, *path);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+#include "event_scheduler.h"
+#include <algorithm>
+
+EventScheduler::EventScheduler() : now(0.0), nextId(1) {}
+
+EventId EventScheduler::Schedule(double delay, std::function<void()> callback) {
+    return ScheduleAt(now + delay, std::move(callback));
+}
+
+EventId EventScheduler::ScheduleAt(double time, std::function<void()> callback) {
+    Event ev;
+    ev.time = std::max(time, now); // Never in the past
+    ev.id = nextId++;
+    ev.callback = std::move(callback);
+
+    EventId id = ev.id;
+    heap.push_back(std::move(ev));
+    std::push_heap(heap.begin(), heap.end(), Later());
+    return id;
+}
+
+void EventScheduler::Cancel(EventId id) {
+    // Rare (cancellation only), so a scan is fine: it keeps 'cancelled' free of already fired IDs
+    for (const auto& ev : heap) {
+        if (ev.id == id) {
+            cancelled.insert(id);
+            return;
+        }
+    }
+}
+
+void EventScheduler::Advance(double dt) {
+    double target = now + dt;
+
+    while (!heap.empty() && heap.front().time <= target) {
+        std::pop_heap(heap.begin(), heap.end(), Later());
+        Event ev = std::move(heap.back());
+        heap.pop_back();
+
+        if (cancelled.erase(ev.id)) continue;
+
+        now = ev.time;
+        ev.callback();
+    }
+    now = target;
+}
+
+void EventScheduler::Clear() {
+    heap.clear();
+    cancelled.clear();
+    now = 0.0;
+}
@@ -0,0 +1,84 @@
+#include "frustum.h"
+#include "raymath.h"
+#include <cmath>
+
+// Plane through 'point' with (inward) normal 'normal'
+static Vector4 PlaneAt(Vector3 normal, Vector3 point) {
+    normal = Vector3Normalize(normal);
+    return { normal.x, normal.y, normal.z, -Vector3DotProduct(normal, point) };
+}
+
+// Side plane containing the eye and the edge direction 'edge', turned towards 'inside'
+static Vector4 SidePlane(Vector3 eye, Vector3 edge, Vector3 axis, Vector3 inside) {
+    Vector3 normal = Vector3CrossProduct(axis, edge);
+    if (Vector3DotProduct(normal, inside) < 0.0f) normal = Vector3Negate(normal);
+    return PlaneAt(normal, eye);
+}
+
+static float PlaneDistance(const Vector4& plane, Vector3 p) {
+    return plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w;
+}
+
+Frustum Frustum::FromCamera(const Camera3D& camera, float aspect, float nearPlane, float farPlane) {
+    Frustum f;
+    Vector3 eye = camera.position;
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+    Vector3 up = Vector3CrossProduct(right, forward);
+
+    f.planes[0] = PlaneAt(forward, Vector3Add(eye, Vector3Scale(forward, nearPlane)));
+    f.planes[1] = PlaneAt(Vector3Negate(forward), Vector3Add(eye, Vector3Scale(forward, farPlane)));
+
+    if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+        // fovy is the height of the view
+        float halfH = camera.fovy * 0.5f, halfW = halfH * aspect;
+        f.planes[2] = PlaneAt(right, Vector3Subtract(eye, Vector3Scale(right, halfW)));
+        f.planes[3] = PlaneAt(Vector3Negate(right), Vector3Add(eye, Vector3Scale(right, halfW)));
+        f.planes[4] = PlaneAt(up, Vector3Subtract(eye, Vector3Scale(up, halfH)));
+        f.planes[5] = PlaneAt(Vector3Negate(up), Vector3Add(eye, Vector3Scale(up, halfH)));
+    } else {
+        float tanV = tanf(camera.fovy * 0.5f * DEG2RAD), tanH = tanV * aspect;
+        f.planes[2] = SidePlane(eye, Vector3Subtract(forward, Vector3Scale(right, tanH)), up, forward);
+        f.planes[3] = SidePlane(eye, Vector3Add(forward, Vector3Scale(right, tanH)), up, forward);
+        f.planes[4] = SidePlane(eye, Vector3Subtract(forward, Vector3Scale(up, tanV)), right, forward);
+        f.planes[5] = SidePlane(eye, Vector3Add(forward, Vector3Scale(up, tanV)), right, forward);
+    }
+    f.eye = eye;
+    f.enabled = true;
+    return f;
+}
+
+bool Frustum::ContainsPoint(Vector3 point) const {
+    return IntersectsSphere(point, 0.0f);
+}
+
+bool Frustum::IntersectsSphere(Vector3 center, float radius) const {
+    if (!enabled) return true;
+    for (const Vector4& plane : planes) {
+        if (PlaneDistance(plane, center) < -radius) return false;
+    }
+    return true;
+}
+
+bool Frustum::IntersectsBox(const BoundingBox& box) const {
+    if (!enabled) return true;
+    for (const Vector4& plane : planes) {
+        // Corner furthest along the normal: if it is outside, the whole box is
+        Vector3 corner = { plane.x >= 0.0f ? box.max.x : box.min.x,
+                           plane.y >= 0.0f ? box.max.y : box.min.y,
+                           plane.z >= 0.0f ? box.max.z : box.min.z };
+        if (PlaneDistance(plane, corner) < 0.0f) return false;
+    }
+    return true;
+}
+
+BoundingBox TransformBox(const BoundingBox& box, const Matrix& transform) {
+    BoundingBox result = { Vector3Transform(box.min, transform), Vector3Transform(box.min, transform) };
+    for (int k = 1; k < 8; k++) {
+        Vector3 corner = { (k & 1) ? box.max.x : box.min.x, (k & 2) ? box.max.y : box.min.y, (k & 4) ? box.max.z : box.min.z };
+        Vector3 p = Vector3Transform(corner, transform);
+        result.min = Vector3Min(result.min, p);
+        result.max = Vector3Max(result.max, p);
+    }
+    return result;
+}
@@ -63,7 +63,7 @@ void InGameMenu::Draw(TrafficInterface& interface, Simulation& simulation, bool&
     
     // Safety Limits
     bool canDecreaseMax = (globalConfig.maxVehicles > configTotal);
-    bool canIncreaseMax = (globalConfig.maxVehicles < 100);
+    bool canIncreaseMax = (globalConfig.maxVehicles < SimulationConfig::MAX_VEHICLE_LIMIT);
 
     // --- +/- BUTTONS ---
     if (DrawPixelButton(panelX + 260, currentY - 5, "-", 30, 30, !canDecreaseMax)) {
@@ -102,7 +102,23 @@ void InGameMenu::Draw(TrafficInterface& interface, Simulation& simulation, bool&
             if (globalConfig.simulationSpeed < 0.5f) globalConfig.simulationSpeed = 0.5f;
         }
     }
-    currentY += 50;
+    currentY += 40;
+
+    // --- 2b. TURBO (10x..1000x, more ticks per frame instead of a longer tick) ---
+    if (globalConfig.turboMultiplier > 0) {
+        DrawText(TextFormat("Turbo: %dx", globalConfig.turboMultiplier), contentX, currentY, 18, MENU_HIGHLIGHT);
+    } else {
+        DrawText("Turbo: OFF", contentX, currentY, 18, MENU_TEXT_COLOR);
+    }
+    bool turboOff = (globalConfig.turboMultiplier <= 0);
+    bool turboMax = (globalConfig.turboMultiplier >= 1000);
+    if (DrawPixelButton(panelX + 260, currentY - 5, "-", 30, 30, turboOff)) {
+        globalConfig.turboMultiplier = NextTurboLevel(globalConfig.turboMultiplier, -1);
+    }
+    if (DrawPixelButton(panelX + 310, currentY - 5, "+", 30, 30, turboMax)) {
+        globalConfig.turboMultiplier = NextTurboLevel(globalConfig.turboMultiplier, 1);
+    }
+    currentY += 45;
 
     // --- 3. VEHICLE LIST ---
     Color limitColor = (configTotal >= globalConfig.maxVehicles) ? RED : GREEN;
@@ -112,7 +128,7 @@ void InGameMenu::Draw(TrafficInterface& interface, Simulation& simulation, bool&
     bool isFull = (configTotal >= globalConfig.maxVehicles);
 
     for (auto& vConfig : globalConfig.vehicleConfigs) {
-        DrawText(TextFormat("%s:", vConfig.type.c_str()), contentX + 20, currentY + 5, 18, MENU_TEXT_COLOR);
+        DrawText(TextFormat("%s:", GetVehicleTypeName(vConfig.type)), contentX + 20, currentY + 5, 18, MENU_TEXT_COLOR);
         
         // Decrease Count
         if (DrawPixelButton(panelX + 260, currentY, "-")) {
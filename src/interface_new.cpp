@@ -213,7 +213,7 @@ void TrafficInterface::DrawSettingsMenu() {
     
     // Safety Limits
     bool canDecrease = (globalConfig.maxVehicles > currentTotal);
-    bool canIncrease = (globalConfig.maxVehicles < 100);
+    bool canIncrease = (globalConfig.maxVehicles < SimulationConfig::MAX_VEHICLE_LIMIT);
     
     // [-] Button
     if (DrawMiniButton((float)startX + 250, (float)startY - 5, "-", !canDecrease)) {
@@ -233,14 +233,25 @@ void TrafficInterface::DrawSettingsMenu() {
     speedSlider.Draw();
     globalConfig.simulationSpeed = speedSlider.currentValue;
 
+    // Turbo (replaces the slider speed while on)
+    startY = 275;
+    if (globalConfig.turboMultiplier > 0) DrawText(TextFormat("Turbo: %dx", globalConfig.turboMultiplier), startX, startY, 20, SKYBLUE);
+    else DrawText("Turbo: OFF", startX, startY, 20, WHITE);
+    if (DrawMiniButton((float)startX + 250, (float)startY - 5, "-", globalConfig.turboMultiplier <= 0)) {
+        globalConfig.turboMultiplier = NextTurboLevel(globalConfig.turboMultiplier, -1);
+    }
+    if (DrawMiniButton((float)startX + 350, (float)startY - 5, "+", globalConfig.turboMultiplier >= 1000)) {
+        globalConfig.turboMultiplier = NextTurboLevel(globalConfig.turboMultiplier, 1);
+    }
+
     // 4. Vehicle List (Same as In-Game)
     bool isFull = (currentTotal >= globalConfig.maxVehicles);
-    startY = 300;
+    startY = 345;
     Color limitColor = isFull ? RED : GREEN;
     DrawText(TextFormat("Utilisation: %d / %d", currentTotal, globalConfig.maxVehicles), startX, startY - 30, 20, limitColor);
 
     for (auto& vConfig : globalConfig.vehicleConfigs) {
-        DrawText(TextFormat("%s:", vConfig.type.c_str()), startX, startY + 5, 20, WHITE);
+        DrawText(TextFormat("%s:", GetVehicleTypeName(vConfig.type)), startX, startY + 5, 20, WHITE);
         if (DrawMiniButton((float)startX + 250, (float)startY, "-", vConfig.count <= 0)) {
             if (vConfig.count > 0) vConfig.count--;
         }
@@ -0,0 +1,320 @@
+#include "job_system.h"
+#include <chrono>
+
+static double Seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+JobSystem::JobSystem(int threadCount) : tasksLeft(0), sleepers(0) {
+    SetThreadCount(threadCount);
+}
+
+JobSystem::~JobSystem() {
+    StopThreads();
+}
+
+// =============================================================================
+//  THREADS
+// =============================================================================
+
+void JobSystem::SetThreadCount(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = (int)std::thread::hardware_concurrency();
+        if (threadCount <= 0) threadCount = 1;
+    }
+    if (threadCount == GetThreadCount()) return;
+
+    StopThreads();
+    queues.clear();
+    for (int i = 0; i < threadCount; i++) queues.emplace_back(new WorkerQueue());
+    threadBusy.assign(threadCount, 0.0);
+    StartThreads(threadCount - 1);
+}
+
+void JobSystem::StartThreads(int count) {
+    stopping = false;
+    for (int i = 0; i < count; i++) {
+        threads.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+}
+
+void JobSystem::StopThreads() {
+    {
+        std::lock_guard<std::mutex> lock(runMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+    threads.clear();
+}
+
+void JobSystem::WorkerLoop(int index) {
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(runMutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        Participate(index);
+    }
+}
+
+// =============================================================================
+//  GRAPH
+// =============================================================================
+
+TaskId JobSystem::AddTask(const std::string& name, std::function<void()> run) {
+    tasks.emplace_back(new Task());
+    tasks.back()->name = name;
+    tasks.back()->run = std::move(run);
+    return (TaskId)tasks.size() - 1;
+}
+
+TaskId JobSystem::AddParallelTask(const std::string& name, std::function<size_t()> count, size_t grain,
+                                  std::function<void(size_t, size_t)> runRange) {
+    tasks.emplace_back(new Task());
+    Task& task = *tasks.back();
+    task.name = name;
+    task.count = std::move(count);
+    task.runRange = std::move(runRange);
+    task.grain = grain > 0 ? grain : 1;
+    return (TaskId)tasks.size() - 1;
+}
+
+void JobSystem::AddDependency(TaskId before, TaskId after) {
+    tasks[before]->successors.push_back(after);
+    tasks[after]->predecessorCount++;
+}
+
+void JobSystem::ClearTasks() {
+    tasks.clear();
+}
+
+// =============================================================================
+//  RUN
+// =============================================================================
+
+void JobSystem::Push(int index, const WorkItem& item) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.items.push_back(item);
+}
+
+bool JobSystem::PopOrSteal(int index, WorkItem& item) {
+    // Own work first, newest first (still warm in cache)
+    {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.items.empty()) {
+            item = own.items.back();
+            own.items.pop_back();
+            return true;
+        }
+    }
+    // Then the oldest work of the others
+    int count = (int)queues.size();
+    for (int offset = 1; offset < count; offset++) {
+        WorkerQueue& victim = *queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.items.empty()) {
+            item = victim.items.front();
+            victim.items.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Yields before an idle thread parks: a short gap between two tasks costs no wake-up
+static const int IDLE_SPINS = 64;
+
+void JobSystem::Participate(int index) {
+    int idle = 0;
+    while (tasksLeft.load() > 0) {
+        WorkItem item;
+        if (PopOrSteal(index, item)) {
+            Execute(index, item);
+            idle = 0;
+        }
+        else if (++idle < IDLE_SPINS) std::this_thread::yield(); // Waiting on a dependency
+        else {
+            Park(index);
+            idle = 0;
+        }
+    }
+}
+
+void JobSystem::Park(int index) {
+    std::unique_lock<std::mutex> lock(idleMutex);
+    unsigned long long epoch = workEpoch;
+    sleepers.fetch_add(1);
+    lock.unlock();
+
+    // Work pushed before 'sleepers' was raised is seen here (queue mutex), work pushed after
+    // sees the sleeper and bumps the epoch
+    WorkItem item;
+    if (PopOrSteal(index, item)) {
+        sleepers.fetch_sub(1);
+        Execute(index, item);
+        return;
+    }
+    lock.lock();
+    idleWake.wait(lock, [&]() { return workEpoch != epoch || tasksLeft.load() == 0; });
+    sleepers.fetch_sub(1);
+}
+
+void JobSystem::WakeIdle() {
+    if (sleepers.load() == 0) return;
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        workEpoch++;
+    }
+    idleWake.notify_all();
+}
+
+void JobSystem::Execute(int index, const WorkItem& item) {
+    Task& task = *tasks[item.task];
+    WorkerQueue& queue = *queues[index];
+    double start = profiling ? Seconds() : 0.0;
+
+    bool done = true;
+    if (!task.count) {
+        task.run();
+    }
+    else if (item.begin == NO_RANGE) {
+        // Parallel task just became ready: cut it into chunks
+        size_t count = task.count();
+        size_t chunks = (count + task.grain - 1) / task.grain;
+        if (chunks > 0) {
+            done = false;
+            task.chunksLeft.store(chunks);
+            // Pushed last-to-first: this thread pops chunk 0 first, thieves take the far end
+            for (size_t c = chunks; c-- > 0;) {
+                size_t begin = c * task.grain;
+                size_t end = begin + task.grain < count ? begin + task.grain : count;
+                Push(index, { item.task, begin, end });
+            }
+            WakeIdle();
+        }
+    }
+    else {
+        task.runRange(item.begin, item.end);
+    }
+
+    // Recorded before the chunk count and Finish publish the item: once the last task is
+    // finished Run reads the profile (and the next Run resets it)
+    if (profiling) {
+        double elapsed = Seconds() - start;
+        queue.taskTime[item.task] += elapsed;
+        queue.taskRan[item.task] = 1;
+        if (item.begin != NO_RANGE) queue.taskChunks[item.task]++;
+        queue.busyTime += elapsed;
+    }
+
+    if (task.count && item.begin != NO_RANGE) done = (task.chunksLeft.fetch_sub(1) == 1);
+    if (done) Finish(index, item.task);
+}
+
+void JobSystem::Finish(int index, TaskId id) {
+    bool pushed = false;
+    for (TaskId next : tasks[id]->successors) {
+        if (tasks[next]->waitingFor.fetch_sub(1) == 1) {
+            Push(index, { next, NO_RANGE, NO_RANGE });
+            pushed = true;
+        }
+    }
+    // The last task also wakes the parked threads: the run is over
+    if (tasksLeft.fetch_sub(1) == 1 || pushed) WakeIdle();
+}
+
+void JobSystem::Run() {
+    if (tasks.empty()) return;
+    double start = profiling ? Seconds() : 0.0;
+    if (profiling) {
+        for (auto& queue : queues) {
+            queue->taskTime.assign(tasks.size(), 0.0);
+            queue->taskChunks.assign(tasks.size(), 0);
+            queue->taskRan.assign(tasks.size(), 0);
+            queue->busyTime = 0.0;
+        }
+    }
+
+    for (auto& task : tasks) {
+        task->waitingFor.store(task->predecessorCount);
+        task->chunksLeft.store(0);
+    }
+    tasksLeft.store((int)tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++) {
+        if (tasks[i]->predecessorCount == 0) Push(0, { (TaskId)i, NO_RANGE, NO_RANGE });
+    }
+
+    if (!threads.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(runMutex);
+            generation++;
+        }
+        wake.notify_all();
+    }
+    Participate(0);
+
+    if (profiling) {
+        runTime += Seconds() - start;
+        CollectProfile();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (grain == 0) grain = 1;
+    // Not worth waking anybody for a single chunk
+    if (threads.empty() || count <= grain) {
+        if (count > 0) body(0, count);
+        return;
+    }
+
+    // Runs as a one-task graph (not callable from inside a task)
+    std::vector<std::unique_ptr<Task>> graph;
+    graph.swap(tasks);
+    AddParallelTask("parallel for", [count]() { return count; }, grain, body);
+    Run();
+    tasks.swap(graph);
+}
+
+// =============================================================================
+//  PROFILING
+// =============================================================================
+
+void JobSystem::SetProfiling(bool enabled) {
+    profiling = enabled;
+}
+
+void JobSystem::ResetProfile() {
+    profile.clear();
+    threadBusy.assign(queues.size(), 0.0);
+    runTime = 0.0;
+}
+
+void JobSystem::CollectProfile() {
+    for (size_t t = 0; t < tasks.size(); t++) {
+        // Merged by name: the same task keeps its line across ParallelFor calls and graph rebuilds
+        TaskProfile* entry = nullptr;
+        for (TaskProfile& p : profile) {
+            if (p.name == tasks[t]->name) { entry = &p; break; }
+        }
+        if (!entry) {
+            profile.push_back(TaskProfile());
+            entry = &profile.back();
+            entry->name = tasks[t]->name;
+        }
+
+        bool ran = false;
+        for (auto& queue : queues) {
+            entry->busyTime += queue->taskTime[t];
+            entry->chunks += queue->taskChunks[t];
+            ran = ran || queue->taskRan[t];
+        }
+        if (ran) entry->runs++;
+    }
+    for (size_t i = 0; i < queues.size(); i++) threadBusy[i] += queues[i]->busyTime;
+}
@@ -0,0 +1,353 @@
+#include "kinematics_kernel.h"
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define KINEMATICS_X86 1
+#include <immintrin.h>
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// =============================================================================
+//  SCALAR REFERENCE
+// =============================================================================
+
+// Same math as the original per-vehicle code of TrafficManager::UpdateVehicles
+static inline float SpeedControlOne(float speed, float desiredSpeed, float gap, float leaderSpeed, int32_t mode,
+                                    const SpeedControlParams& p) {
+    if (mode == SPEED_FROZEN) return speed;
+    if (mode == SPEED_FORCED) return p.forcedSpeed;
+
+    float targetSpeed = desiredSpeed;
+    float dynamicSlowingDist = p.startSlowingDist + (speed * 1.5f);
+
+    if (mode == SPEED_STOP) {
+        targetSpeed = 0.0f;
+    }
+    else if (gap < p.minSafeDist) {
+        targetSpeed = 0.0f;
+    }
+    else if (gap < dynamicSlowingDist) {
+        float factor = (gap - p.minSafeDist) / (dynamicSlowingDist - p.minSafeDist);
+        targetSpeed = leaderSpeed + (desiredSpeed - leaderSpeed) * factor;
+    }
+
+    // Physics Smoothing
+    float acceleration = 10.0f;
+    float braking = 15.0f + (speed * 0.5f);
+    if (gap < p.minSafeDist + 2.0f && speed > 1.0f) braking = 50.0f;
+
+    if (speed > targetSpeed) {
+        speed -= braking * p.dt;
+        if (speed < targetSpeed) speed = targetSpeed;
+    }
+    else {
+        speed += acceleration * p.dt;
+        if (speed > targetSpeed) speed = targetSpeed;
+    }
+    if (speed < 0.0f) speed = 0.0f;
+    return speed;
+}
+
+void SpeedControlScalar(const SpeedControlInput& in, float* outSpeed, size_t count, const SpeedControlParams& p) {
+    for (size_t i = 0; i < count; i++) {
+        outSpeed[i] = SpeedControlOne(in.speed[i], in.desiredSpeed[i], in.gap[i], in.leaderSpeed[i], in.mode[i], p);
+    }
+}
+
+void SteerScalar(const SteeringArrays& a, size_t count, float dt, float arrivalThreshold) {
+    float turnRate = fminf(12.0f * dt, 1.0f); // Never steer past the target direction
+    for (size_t i = 0; i < count; i++) {
+        a.arrived[i] = 0;
+        if (!a.active[i]) continue;
+
+        float dx = a.targetX[i] - a.posX[i];
+        float dy = a.targetY[i] - a.posY[i];
+        float dz = a.targetZ[i] - a.posZ[i];
+        float dist = sqrtf(dx*dx + dy*dy + dz*dz);
+        float step = a.speed[i] * dt;
+        if (dist < arrivalThreshold || step >= dist) {
+            a.arrived[i] = 1;
+            continue;
+        }
+
+        // Direction (dist >= threshold > 0 here), smooth steering, re-normalized heading
+        dx /= dist;
+        dz /= dist;
+        float fx = a.fwdX[i] + (dx - a.fwdX[i]) * turnRate;
+        float fz = a.fwdZ[i] + (dz - a.fwdZ[i]) * turnRate;
+        float fMag = sqrtf(fx*fx + fz*fz);
+        if (fMag > 0) {
+            fx /= fMag;
+            fz /= fMag;
+        }
+        a.fwdX[i] = fx;
+        a.fwdZ[i] = fz;
+        a.posX[i] += fx * step;
+        a.posZ[i] += fz * step;
+    }
+}
+
+// =============================================================================
+//  SSE2 (4 vehicles)
+// =============================================================================
+#ifdef KINEMATICS_X86
+
+TARGET_SSE2 static void SpeedControlSSE2(const SpeedControlInput& in, float* out, size_t count, const SpeedControlParams& p) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 minSafe = _mm_set1_ps(p.minSafeDist);
+    const __m128 minSafePlus2 = _mm_set1_ps(p.minSafeDist + 2.0f);
+    const __m128 startSlowing = _mm_set1_ps(p.startSlowingDist);
+    const __m128 forced = _mm_set1_ps(p.forcedSpeed);
+    const __m128 dt = _mm_set1_ps(p.dt);
+    const __m128 accelStep = _mm_mul_ps(_mm_set1_ps(10.0f), dt);
+    const __m128i stopMode = _mm_set1_epi32(SPEED_STOP);
+    const __m128i forcedMode = _mm_set1_epi32(SPEED_FORCED);
+    const __m128i frozenMode = _mm_set1_epi32(SPEED_FROZEN);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 speed = _mm_loadu_ps(in.speed + i);
+        __m128 desired = _mm_loadu_ps(in.desiredSpeed + i);
+        __m128 gap = _mm_loadu_ps(in.gap + i);
+        __m128 leader = _mm_loadu_ps(in.leaderSpeed + i);
+        __m128i mode = _mm_loadu_si128((const __m128i*)(in.mode + i));
+
+        // Target speed
+        __m128 slowing = _mm_add_ps(startSlowing, _mm_mul_ps(speed, _mm_set1_ps(1.5f)));
+        __m128 factor = _mm_div_ps(_mm_sub_ps(gap, minSafe), _mm_sub_ps(slowing, minSafe));
+        __m128 follow = _mm_add_ps(leader, _mm_mul_ps(_mm_sub_ps(desired, leader), factor));
+        __m128 inSlowing = _mm_cmplt_ps(gap, slowing);
+        __m128 target = _mm_or_ps(_mm_and_ps(inSlowing, follow), _mm_andnot_ps(inSlowing, desired));
+        __m128 stop = _mm_or_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(mode, stopMode)), _mm_cmplt_ps(gap, minSafe));
+        target = _mm_andnot_ps(stop, target);
+
+        // Acceleration / braking clamp
+        __m128 hardBrake = _mm_and_ps(_mm_cmplt_ps(gap, minSafePlus2), _mm_cmpgt_ps(speed, _mm_set1_ps(1.0f)));
+        __m128 braking = _mm_add_ps(_mm_set1_ps(15.0f), _mm_mul_ps(speed, _mm_set1_ps(0.5f)));
+        braking = _mm_or_ps(_mm_and_ps(hardBrake, _mm_set1_ps(50.0f)), _mm_andnot_ps(hardBrake, braking));
+        __m128 slower = _mm_max_ps(_mm_sub_ps(speed, _mm_mul_ps(braking, dt)), target);
+        __m128 faster = _mm_min_ps(_mm_add_ps(speed, accelStep), target);
+        __m128 above = _mm_cmpgt_ps(speed, target);
+        __m128 result = _mm_or_ps(_mm_and_ps(above, slower), _mm_andnot_ps(above, faster));
+        result = _mm_max_ps(result, zero);
+
+        // Forced / frozen vehicles
+        __m128 isForced = _mm_castsi128_ps(_mm_cmpeq_epi32(mode, forcedMode));
+        __m128 isFrozen = _mm_castsi128_ps(_mm_cmpeq_epi32(mode, frozenMode));
+        result = _mm_or_ps(_mm_and_ps(isForced, forced), _mm_andnot_ps(isForced, result));
+        result = _mm_or_ps(_mm_and_ps(isFrozen, speed), _mm_andnot_ps(isFrozen, result));
+        _mm_storeu_ps(out + i, result);
+    }
+
+    SpeedControlInput tail = { in.speed + i, in.desiredSpeed + i, in.gap + i, in.leaderSpeed + i, in.mode + i };
+    SpeedControlScalar(tail, out + i, count - i, p);
+}
+
+TARGET_SSE2 static void SteerSSE2(const SteeringArrays& a, size_t count, float dtValue, float arrivalThreshold) {
+    const __m128 dt = _mm_set1_ps(dtValue);
+    const __m128 threshold = _mm_set1_ps(arrivalThreshold);
+    const __m128 turnRate = _mm_set1_ps(fminf(12.0f * dtValue, 1.0f));
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(a.posX + i);
+        __m128 pz = _mm_loadu_ps(a.posZ + i);
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(a.targetX + i), px);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(a.targetY + i), _mm_loadu_ps(a.posY + i));
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(a.targetZ + i), pz);
+        __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        __m128 step = _mm_mul_ps(_mm_loadu_ps(a.speed + i), dt);
+
+        __m128 active = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a.active + i)), _mm_setzero_si128()));
+        active = _mm_xor_ps(active, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+        __m128 arrive = _mm_and_ps(active, _mm_or_ps(_mm_cmplt_ps(dist, threshold), _mm_cmpge_ps(step, dist)));
+        __m128 move = _mm_andnot_ps(arrive, active);
+
+        int arriveBits = _mm_movemask_ps(arrive);
+        for (int l = 0; l < 4; l++) a.arrived[i + l] = (unsigned char)((arriveBits >> l) & 1);
+        if (_mm_movemask_ps(move) == 0) continue;
+
+        __m128 fwdX = _mm_loadu_ps(a.fwdX + i);
+        __m128 fwdZ = _mm_loadu_ps(a.fwdZ + i);
+        __m128 nx = _mm_div_ps(dx, dist);
+        __m128 nz = _mm_div_ps(dz, dist);
+        __m128 fx = _mm_add_ps(fwdX, _mm_mul_ps(_mm_sub_ps(nx, fwdX), turnRate));
+        __m128 fz = _mm_add_ps(fwdZ, _mm_mul_ps(_mm_sub_ps(nz, fwdZ), turnRate));
+        __m128 mag = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(fx, fx), _mm_mul_ps(fz, fz)));
+        __m128 positive = _mm_cmpgt_ps(mag, zero);
+        fx = _mm_or_ps(_mm_and_ps(positive, _mm_div_ps(fx, mag)), _mm_andnot_ps(positive, fx));
+        fz = _mm_or_ps(_mm_and_ps(positive, _mm_div_ps(fz, mag)), _mm_andnot_ps(positive, fz));
+
+        _mm_storeu_ps(a.fwdX + i, _mm_or_ps(_mm_and_ps(move, fx), _mm_andnot_ps(move, fwdX)));
+        _mm_storeu_ps(a.fwdZ + i, _mm_or_ps(_mm_and_ps(move, fz), _mm_andnot_ps(move, fwdZ)));
+        _mm_storeu_ps(a.posX + i, _mm_or_ps(_mm_and_ps(move, _mm_add_ps(px, _mm_mul_ps(fx, step))), _mm_andnot_ps(move, px)));
+        _mm_storeu_ps(a.posZ + i, _mm_or_ps(_mm_and_ps(move, _mm_add_ps(pz, _mm_mul_ps(fz, step))), _mm_andnot_ps(move, pz)));
+    }
+
+    SteeringArrays tail = { a.posX + i, a.posY + i, a.posZ + i, a.fwdX + i, a.fwdZ + i, a.speed + i,
+                            a.targetX + i, a.targetY + i, a.targetZ + i, a.active + i, a.arrived + i };
+    SteerScalar(tail, count - i, dtValue, arrivalThreshold);
+}
+
+// =============================================================================
+//  AVX2 (8 vehicles)
+// =============================================================================
+
+TARGET_AVX2 static void SpeedControlAVX2(const SpeedControlInput& in, float* out, size_t count, const SpeedControlParams& p) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 minSafe = _mm256_set1_ps(p.minSafeDist);
+    const __m256 minSafePlus2 = _mm256_set1_ps(p.minSafeDist + 2.0f);
+    const __m256 startSlowing = _mm256_set1_ps(p.startSlowingDist);
+    const __m256 forced = _mm256_set1_ps(p.forcedSpeed);
+    const __m256 dt = _mm256_set1_ps(p.dt);
+    const __m256 accelStep = _mm256_mul_ps(_mm256_set1_ps(10.0f), dt);
+    const __m256i stopMode = _mm256_set1_epi32(SPEED_STOP);
+    const __m256i forcedMode = _mm256_set1_epi32(SPEED_FORCED);
+    const __m256i frozenMode = _mm256_set1_epi32(SPEED_FROZEN);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 speed = _mm256_loadu_ps(in.speed + i);
+        __m256 desired = _mm256_loadu_ps(in.desiredSpeed + i);
+        __m256 gap = _mm256_loadu_ps(in.gap + i);
+        __m256 leader = _mm256_loadu_ps(in.leaderSpeed + i);
+        __m256i mode = _mm256_loadu_si256((const __m256i*)(in.mode + i));
+
+        // Target speed
+        __m256 slowing = _mm256_add_ps(startSlowing, _mm256_mul_ps(speed, _mm256_set1_ps(1.5f)));
+        __m256 factor = _mm256_div_ps(_mm256_sub_ps(gap, minSafe), _mm256_sub_ps(slowing, minSafe));
+        __m256 follow = _mm256_add_ps(leader, _mm256_mul_ps(_mm256_sub_ps(desired, leader), factor));
+        __m256 target = _mm256_blendv_ps(desired, follow, _mm256_cmp_ps(gap, slowing, _CMP_LT_OQ));
+        __m256 stop = _mm256_or_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(mode, stopMode)),
+                                   _mm256_cmp_ps(gap, minSafe, _CMP_LT_OQ));
+        target = _mm256_andnot_ps(stop, target);
+
+        // Acceleration / braking clamp
+        __m256 hardBrake = _mm256_and_ps(_mm256_cmp_ps(gap, minSafePlus2, _CMP_LT_OQ),
+                                         _mm256_cmp_ps(speed, _mm256_set1_ps(1.0f), _CMP_GT_OQ));
+        __m256 braking = _mm256_add_ps(_mm256_set1_ps(15.0f), _mm256_mul_ps(speed, _mm256_set1_ps(0.5f)));
+        braking = _mm256_blendv_ps(braking, _mm256_set1_ps(50.0f), hardBrake);
+        __m256 slower = _mm256_max_ps(_mm256_sub_ps(speed, _mm256_mul_ps(braking, dt)), target);
+        __m256 faster = _mm256_min_ps(_mm256_add_ps(speed, accelStep), target);
+        __m256 result = _mm256_blendv_ps(faster, slower, _mm256_cmp_ps(speed, target, _CMP_GT_OQ));
+        result = _mm256_max_ps(result, zero);
+
+        // Forced / frozen vehicles
+        result = _mm256_blendv_ps(result, forced, _mm256_castsi256_ps(_mm256_cmpeq_epi32(mode, forcedMode)));
+        result = _mm256_blendv_ps(result, speed, _mm256_castsi256_ps(_mm256_cmpeq_epi32(mode, frozenMode)));
+        _mm256_storeu_ps(out + i, result);
+    }
+
+    SpeedControlInput tail = { in.speed + i, in.desiredSpeed + i, in.gap + i, in.leaderSpeed + i, in.mode + i };
+    SpeedControlSSE2(tail, out + i, count - i, p);
+}
+
+TARGET_AVX2 static void SteerAVX2(const SteeringArrays& a, size_t count, float dtValue, float arrivalThreshold) {
+    const __m256 dt = _mm256_set1_ps(dtValue);
+    const __m256 threshold = _mm256_set1_ps(arrivalThreshold);
+    const __m256 turnRate = _mm256_set1_ps(fminf(12.0f * dtValue, 1.0f));
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(a.posX + i);
+        __m256 pz = _mm256_loadu_ps(a.posZ + i);
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(a.targetX + i), px);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(a.targetY + i), _mm256_loadu_ps(a.posY + i));
+        __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(a.targetZ + i), pz);
+        __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                                   _mm256_mul_ps(dz, dz)));
+        __m256 step = _mm256_mul_ps(_mm256_loadu_ps(a.speed + i), dt);
+
+        __m256i inactive = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a.active + i)), _mm256_setzero_si256());
+        __m256 active = _mm256_castsi256_ps(_mm256_xor_si256(inactive, _mm256_set1_epi32(-1)));
+        __m256 arrive = _mm256_and_ps(active, _mm256_or_ps(_mm256_cmp_ps(dist, threshold, _CMP_LT_OQ),
+                                                           _mm256_cmp_ps(step, dist, _CMP_GE_OQ)));
+        __m256 move = _mm256_andnot_ps(arrive, active);
+
+        int arriveBits = _mm256_movemask_ps(arrive);
+        for (int l = 0; l < 8; l++) a.arrived[i + l] = (unsigned char)((arriveBits >> l) & 1);
+        if (_mm256_movemask_ps(move) == 0) continue;
+
+        __m256 fwdX = _mm256_loadu_ps(a.fwdX + i);
+        __m256 fwdZ = _mm256_loadu_ps(a.fwdZ + i);
+        __m256 nx = _mm256_div_ps(dx, dist);
+        __m256 nz = _mm256_div_ps(dz, dist);
+        __m256 fx = _mm256_add_ps(fwdX, _mm256_mul_ps(_mm256_sub_ps(nx, fwdX), turnRate));
+        __m256 fz = _mm256_add_ps(fwdZ, _mm256_mul_ps(_mm256_sub_ps(nz, fwdZ), turnRate));
+        __m256 mag = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(fx, fx), _mm256_mul_ps(fz, fz)));
+        __m256 positive = _mm256_cmp_ps(mag, zero, _CMP_GT_OQ);
+        fx = _mm256_blendv_ps(fx, _mm256_div_ps(fx, mag), positive);
+        fz = _mm256_blendv_ps(fz, _mm256_div_ps(fz, mag), positive);
+
+        _mm256_storeu_ps(a.fwdX + i, _mm256_blendv_ps(fwdX, fx, move));
+        _mm256_storeu_ps(a.fwdZ + i, _mm256_blendv_ps(fwdZ, fz, move));
+        _mm256_storeu_ps(a.posX + i, _mm256_blendv_ps(px, _mm256_add_ps(px, _mm256_mul_ps(fx, step)), move));
+        _mm256_storeu_ps(a.posZ + i, _mm256_blendv_ps(pz, _mm256_add_ps(pz, _mm256_mul_ps(fz, step)), move));
+    }
+
+    SteeringArrays tail = { a.posX + i, a.posY + i, a.posZ + i, a.fwdX + i, a.fwdZ + i, a.speed + i,
+                            a.targetX + i, a.targetY + i, a.targetZ + i, a.active + i, a.arrived + i };
+    SteerSSE2(tail, count - i, dtValue, arrivalThreshold);
+}
+
+#endif // KINEMATICS_X86
+
+// =============================================================================
+//  DISPATCH
+// =============================================================================
+
+KinematicsLevel GetBestKinematicsLevel() {
+#ifdef KINEMATICS_X86
+    static const KinematicsLevel best = __builtin_cpu_supports("avx2") ? KINEMATICS_AVX2
+                                      : __builtin_cpu_supports("sse2") ? KINEMATICS_SSE2 : KINEMATICS_SCALAR;
+    return best;
+#else
+    return KINEMATICS_SCALAR;
+#endif
+}
+
+static KinematicsLevel& CurrentLevel() {
+    static KinematicsLevel level = GetBestKinematicsLevel();
+    return level;
+}
+
+KinematicsLevel GetKinematicsLevel() {
+    return CurrentLevel();
+}
+
+void SetKinematicsLevel(KinematicsLevel level) {
+    CurrentLevel() = level < GetBestKinematicsLevel() ? level : GetBestKinematicsLevel();
+}
+
+const char* GetKinematicsLevelName(KinematicsLevel level) {
+    switch (level) {
+        case KINEMATICS_AVX2: return "avx2";
+        case KINEMATICS_SSE2: return "sse2";
+        default:              return "scalar";
+    }
+}
+
+void SpeedControlBatch(const SpeedControlInput& in, float* outSpeed, size_t count, const SpeedControlParams& p) {
+#ifdef KINEMATICS_X86
+    switch (CurrentLevel()) {
+        case KINEMATICS_AVX2: SpeedControlAVX2(in, outSpeed, count, p); return;
+        case KINEMATICS_SSE2: SpeedControlSSE2(in, outSpeed, count, p); return;
+        default: break;
+    }
+#endif
+    SpeedControlScalar(in, outSpeed, count, p);
+}
+
+void SteerBatch(const SteeringArrays& a, size_t count, float dt, float arrivalThreshold) {
+#ifdef KINEMATICS_X86
+    switch (CurrentLevel()) {
+        case KINEMATICS_AVX2: SteerAVX2(a, count, dt, arrivalThreshold); return;
+        case KINEMATICS_SSE2: SteerSSE2(a, count, dt, arrivalThreshold); return;
+        default: break;
+    }
+#endif
+    SteerScalar(a, count, dt, arrivalThreshold);
+}
@@ -0,0 +1,342 @@
+#include "mesh_builder.h"
+#include "raymath.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <cfloat>
+#include <map>
+
+// Direction through the rotation part of 'm' only
+static Vector3 TurnDirection(Vector3 v, Matrix m) {
+    return { m.m0 * v.x + m.m4 * v.y + m.m8 * v.z,
+             m.m1 * v.x + m.m5 * v.y + m.m9 * v.z,
+             m.m2 * v.x + m.m6 * v.y + m.m10 * v.z };
+}
+
+MeshBuilder::MeshBuilder() : transform(MatrixIdentity()) {}
+
+// --- Transform ---
+
+void MeshBuilder::PushMatrix() {
+    stack.push_back(transform);
+}
+
+void MeshBuilder::PopMatrix() {
+    if (stack.empty()) return;
+    transform = stack.back();
+    stack.pop_back();
+}
+
+void MeshBuilder::Translate(float x, float y, float z) {
+    // Same order as rlgl: the new operation applies before what is already on the matrix
+    transform = MatrixMultiply(MatrixTranslate(x, y, z), transform);
+}
+
+void MeshBuilder::Rotate(float angle, float x, float y, float z) {
+    Vector3 axis = Vector3Normalize({ x, y, z });
+    transform = MatrixMultiply(MatrixRotate(axis, angle * DEG2RAD), transform);
+}
+
+// --- Primitives ---
+
+void MeshBuilder::AddTriangle(Vector3 a, Vector3 b, Vector3 c, Vector3 normal, Color color) {
+    a = Vector3Transform(a, transform);
+    b = Vector3Transform(b, transform);
+    c = Vector3Transform(c, transform);
+    normal = Vector3Normalize(TurnDirection(normal, transform));
+
+    Vector3 facing = Vector3CrossProduct(Vector3Subtract(b, a), Vector3Subtract(c, a));
+    if (Vector3LengthSqr(facing) < 1e-10f) return;   // No area (flat cube side, cone tip)
+    // Under the ground, looking down: never seen from above
+    if (normal.y < -0.99f && a.y <= 0.001f && b.y <= 0.001f && c.y <= 0.001f) return;
+
+    if (Vector3DotProduct(facing, normal) < 0.0f) std::swap(b, c);
+    positions.push_back(a);
+    positions.push_back(b);
+    positions.push_back(c);
+    for (int k = 0; k < 3; k++) {
+        normals.push_back(normal);
+        colors.push_back(color);
+    }
+}
+
+void MeshBuilder::AddQuad(Vector3 a, Vector3 b, Vector3 c, Vector3 d, Vector3 normal, Color color) {
+    AddTriangle(a, b, c, normal, color);
+    AddTriangle(a, c, d, normal, color);
+}
+
+void MeshBuilder::AddLine(Vector3 a, Vector3 b, Color color) {
+    linePoints.push_back(Vector3Transform(a, transform));
+    linePoints.push_back(Vector3Transform(b, transform));
+    lineColors.push_back(color);
+    lineColors.push_back(color);
+}
+
+// --- raylib shapes ---
+
+void MeshBuilder::AddCube(Vector3 position, float width, float height, float length, Color color) {
+    float hx = width / 2.0f, hy = height / 2.0f, hz = length / 2.0f;
+    auto corner = [&](float x, float y, float z) { return Vector3{ position.x + x, position.y + y, position.z + z }; };
+
+    AddQuad(corner(-hx, hy, -hz), corner(hx, hy, -hz), corner(hx, hy, hz), corner(-hx, hy, hz), { 0, 1, 0 }, color);
+    AddQuad(corner(-hx, -hy, -hz), corner(hx, -hy, -hz), corner(hx, -hy, hz), corner(-hx, -hy, hz), { 0, -1, 0 }, color);
+    AddQuad(corner(hx, -hy, -hz), corner(hx, hy, -hz), corner(hx, hy, hz), corner(hx, -hy, hz), { 1, 0, 0 }, color);
+    AddQuad(corner(-hx, -hy, -hz), corner(-hx, hy, -hz), corner(-hx, hy, hz), corner(-hx, -hy, hz), { -1, 0, 0 }, color);
+    AddQuad(corner(-hx, -hy, hz), corner(hx, -hy, hz), corner(hx, hy, hz), corner(-hx, hy, hz), { 0, 0, 1 }, color);
+    AddQuad(corner(-hx, -hy, -hz), corner(hx, -hy, -hz), corner(hx, hy, -hz), corner(-hx, hy, -hz), { 0, 0, -1 }, color);
+}
+
+void MeshBuilder::AddCubeWires(Vector3 position, float width, float height, float length, Color color) {
+    float hx = width / 2.0f, hy = height / 2.0f, hz = length / 2.0f;
+    auto corner = [&](float x, float y, float z) { return Vector3{ position.x + x, position.y + y, position.z + z }; };
+
+    const float xs[4] = { -hx, hx, hx, -hx };
+    const float zs[4] = { -hz, -hz, hz, hz };
+    for (int k = 0; k < 4; k++) {
+        int n = (k + 1) % 4;
+        AddLine(corner(xs[k], hy, zs[k]), corner(xs[n], hy, zs[n]), color);
+        if (height <= 0.0f) continue;   // Flat: top and bottom outlines are the same lines
+        AddLine(corner(xs[k], -hy, zs[k]), corner(xs[n], -hy, zs[n]), color);
+        AddLine(corner(xs[k], -hy, zs[k]), corner(xs[k], hy, zs[k]), color);
+    }
+}
+
+void MeshBuilder::AddPlane(Vector3 center, Vector2 size, Color color) {
+    float hx = size.x / 2.0f, hz = size.y / 2.0f;
+    AddQuad({ center.x - hx, center.y, center.z - hz }, { center.x + hx, center.y, center.z - hz },
+            { center.x + hx, center.y, center.z + hz }, { center.x - hx, center.y, center.z + hz }, { 0, 1, 0 }, color);
+}
+
+void MeshBuilder::AddCylinder(Vector3 position, float radiusTop, float radiusBottom, float height, int slices, Color color) {
+    if (slices < 3) slices = 3;
+    // Same points as DrawCylinder (x = sin, z = cos)
+    for (int i = 0; i < slices; i++) {
+        float a1 = DEG2RAD * i * 360.0f / slices, a2 = DEG2RAD * (i + 1) * 360.0f / slices;
+        Vector3 b1 = { position.x + sinf(a1) * radiusBottom, position.y, position.z + cosf(a1) * radiusBottom };
+        Vector3 b2 = { position.x + sinf(a2) * radiusBottom, position.y, position.z + cosf(a2) * radiusBottom };
+        Vector3 t1 = { position.x + sinf(a1) * radiusTop, position.y + height, position.z + cosf(a1) * radiusTop };
+        Vector3 t2 = { position.x + sinf(a2) * radiusTop, position.y + height, position.z + cosf(a2) * radiusTop };
+        float mid = (a1 + a2) / 2.0f;
+        Vector3 side = Vector3Normalize({ sinf(mid) * height, radiusBottom - radiusTop, cosf(mid) * height });
+        AddQuad(b1, b2, t2, t1, side, color);
+        if (radiusTop > 0.0f) AddTriangle({ position.x, position.y + height, position.z }, t1, t2, { 0, 1, 0 }, color);
+        if (radiusBottom > 0.0f) AddTriangle(position, b1, b2, { 0, -1, 0 }, color);
+    }
+}
+
+void MeshBuilder::AddCylinderWires(Vector3 position, float radiusTop, float radiusBottom, float height, int slices, Color color) {
+    if (slices < 3) slices = 3;
+    for (int i = 0; i < slices; i++) {
+        float a1 = DEG2RAD * i * 360.0f / slices, a2 = DEG2RAD * (i + 1) * 360.0f / slices;
+        Vector3 b1 = { position.x + sinf(a1) * radiusBottom, position.y, position.z + cosf(a1) * radiusBottom };
+        Vector3 b2 = { position.x + sinf(a2) * radiusBottom, position.y, position.z + cosf(a2) * radiusBottom };
+        Vector3 t1 = { position.x + sinf(a1) * radiusTop, position.y + height, position.z + cosf(a1) * radiusTop };
+        Vector3 t2 = { position.x + sinf(a2) * radiusTop, position.y + height, position.z + cosf(a2) * radiusTop };
+        AddLine(b1, b2, color);
+        AddLine(t1, t2, color);
+        AddLine(b2, t2, color);
+    }
+}
+
+void MeshBuilder::AddCylinderEx(Vector3 startPos, Vector3 endPos, float startRadius, float endRadius, int sides, Color color) {
+    if (sides < 3) sides = 3;
+    Vector3 direction = Vector3Subtract(endPos, startPos);
+    if (Vector3LengthSqr(direction) < 1e-8f) return;
+    Vector3 axis = Vector3Normalize(direction);
+
+    // Two directions across the axis (as DrawCylinderEx)
+    Vector3 b1 = Vector3Normalize(Vector3Perpendicular(direction));
+    Vector3 b2 = Vector3Normalize(Vector3CrossProduct(b1, direction));
+
+    float step = 2.0f * PI / sides;
+    for (int i = 0; i < sides; i++) {
+        Vector3 w1 = Vector3Add(Vector3Scale(b1, cosf(i * step)), Vector3Scale(b2, sinf(i * step)));
+        Vector3 w2 = Vector3Add(Vector3Scale(b1, cosf((i + 1) * step)), Vector3Scale(b2, sinf((i + 1) * step)));
+        Vector3 s1 = Vector3Add(startPos, Vector3Scale(w1, startRadius));
+        Vector3 s2 = Vector3Add(startPos, Vector3Scale(w2, startRadius));
+        Vector3 e1 = Vector3Add(endPos, Vector3Scale(w1, endRadius));
+        Vector3 e2 = Vector3Add(endPos, Vector3Scale(w2, endRadius));
+        AddQuad(s1, s2, e2, e1, Vector3Normalize(Vector3Add(w1, w2)), color);
+        if (startRadius > 0.0f) AddTriangle(startPos, s2, s1, Vector3Negate(axis), color);
+        if (endRadius > 0.0f) AddTriangle(endPos, e1, e2, axis, color);
+    }
+}
+
+void MeshBuilder::AddSphere(Vector3 center, float radius, Color color) {
+    // DrawSphere resolution: 16 rings, 16 slices
+    const int RINGS = 16, SLICES = 16;
+    auto point = [&](int ring, int slice) {
+        float lat = PI * ring / RINGS - PI / 2.0f;
+        float lon = 2.0f * PI * slice / SLICES;
+        Vector3 dir = { cosf(lat) * sinf(lon), sinf(lat), cosf(lat) * cosf(lon) };
+        return Vector3Add(center, Vector3Scale(dir, radius));
+    };
+    for (int r = 0; r < RINGS; r++) {
+        for (int s = 0; s < SLICES; s++) {
+            Vector3 p1 = point(r, s), p2 = point(r, s + 1), p3 = point(r + 1, s + 1), p4 = point(r + 1, s);
+            Vector3 mid = Vector3Scale(Vector3Add(Vector3Add(p1, p2), Vector3Add(p3, p4)), 0.25f);
+            Vector3 out = Vector3Normalize(Vector3Subtract(mid, center));
+            // Quads at the poles have one side of zero length: AddTriangle drops the empty half
+            AddQuad(p1, p2, p3, p4, out, color);
+        }
+    }
+}
+
+void MeshBuilder::AddRing(Vector3 center, float innerRadius, float outerRadius, float startAngle, float endAngle, int segments, Color color) {
+    float step = (endAngle - startAngle) / segments;
+    for (int i = 0; i < segments; i++) {
+        float a1 = (startAngle + i * step) * DEG2RAD;
+        float a2 = (startAngle + (i + 1) * step) * DEG2RAD;
+        Vector3 in1 = { center.x + cosf(a1) * innerRadius, center.y, center.z + sinf(a1) * innerRadius };
+        Vector3 out1 = { center.x + cosf(a1) * outerRadius, center.y, center.z + sinf(a1) * outerRadius };
+        Vector3 in2 = { center.x + cosf(a2) * innerRadius, center.y, center.z + sinf(a2) * innerRadius };
+        Vector3 out2 = { center.x + cosf(a2) * outerRadius, center.y, center.z + sinf(a2) * outerRadius };
+        AddQuad(in1, out1, out2, in2, { 0, 1, 0 }, color);
+    }
+}
+
+void MeshBuilder::Clear() {
+    positions.clear();
+    normals.clear();
+    colors.clear();
+    linePoints.clear();
+    lineColors.clear();
+    transform = MatrixIdentity();
+    stack.clear();
+}
+
+// --- BakedGeometry ---
+
+// Tile of a point on the XZ grid (a single tile without a tile size)
+static std::pair<int, int> TileOf(float x, float z, float tileSize) {
+    if (tileSize <= 0.0f) return { 0, 0 };
+    return { (int)floorf(x / tileSize), (int)floorf(z / tileSize) };
+}
+
+static BoundingBox EmptyBox() {
+    return { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+}
+
+static void Enclose(BoundingBox& box, Vector3 p) {
+    box.min = Vector3Min(box.min, p);
+    box.max = Vector3Max(box.max, p);
+}
+
+// Outline segments become thin quads in the meshes (no line batch rebuilt every frame): one flat
+// and one upright quad along the segment, both sides, so it shows from any view
+static const float OUTLINE_WIDTH = 0.06f;
+
+static void AddOutlineQuads(Vector3 a, Vector3 b, Color color, std::vector<Vector3>& positions,
+                            std::vector<Vector3>& normals, std::vector<Color>& colors) {
+    Vector3 dir = Vector3Subtract(b, a);
+    if (Vector3LengthSqr(dir) < 1e-10f) return;
+    dir = Vector3Normalize(dir);
+    Vector3 side = Vector3CrossProduct(dir, { 0.0f, 1.0f, 0.0f });
+    if (Vector3LengthSqr(side) < 1e-6f) side = { 1.0f, 0.0f, 0.0f };   // Vertical segment: two upright quads
+    side = Vector3Normalize(side);
+    Vector3 lift = Vector3CrossProduct(side, dir);
+
+    Vector3 acrosses[2] = { side, lift };
+    for (Vector3 across : acrosses) {
+        Vector3 h = Vector3Scale(across, OUTLINE_WIDTH * 0.5f);
+        Vector3 q[4] = { Vector3Subtract(a, h), Vector3Subtract(b, h), Vector3Add(b, h), Vector3Add(a, h) };
+        Vector3 normal = Vector3CrossProduct(dir, across);
+        // Front (counter-clockwise around 'normal'), then back
+        const int corners[12] = { 0, 1, 2, 0, 2, 3, 0, 2, 1, 0, 3, 2 };
+        for (int k = 0; k < 12; k++) {
+            positions.push_back(q[corners[k]]);
+            normals.push_back(k < 6 ? normal : Vector3Negate(normal));
+            colors.push_back(color);
+        }
+    }
+}
+
+void BakedGeometry::Load(const MeshBuilder& builder, float tileSize) {
+    Unload();
+    bounds = EmptyBox();
+
+    // Triangles of the builder, then its outlines as quads
+    std::vector<Vector3> positions = builder.positions;
+    std::vector<Vector3> normals = builder.normals;
+    std::vector<Color> colors = builder.colors;
+    for (int l = 0; l < builder.GetLineCount(); l++) {
+        AddOutlineQuads(builder.linePoints[2 * l], builder.linePoints[2 * l + 1], builder.lineColors[2 * l],
+                        positions, normals, colors);
+    }
+
+    // Triangles per tile (ordered map: the same meshes from one run to the next)
+    std::map<std::pair<int, int>, std::vector<int>> triangles;
+    int triangleCount = (int)positions.size() / 3;
+    for (int t = 0; t < triangleCount; t++) {
+        const Vector3* v = &positions[3 * t];
+        triangles[TileOf((v[0].x + v[1].x + v[2].x) / 3.0f, (v[0].z + v[1].z + v[2].z) / 3.0f, tileSize)].push_back(t);
+    }
+
+    const int MAX_TRIANGLES = MAX_MESH_VERTICES / 3;
+    for (const auto& tile : triangles) {
+        const std::vector<int>& list = tile.second;
+        for (size_t first = 0; first < list.size(); first += MAX_TRIANGLES) {
+            int count = list.size() - first < (size_t)MAX_TRIANGLES ? (int)(list.size() - first) : MAX_TRIANGLES;
+            Mesh mesh = {};
+            mesh.vertexCount = count * 3;
+            mesh.triangleCount = count;
+            // raylib frees these with the mesh (UnloadMesh)
+            mesh.vertices = (float*)MemAlloc(count * 3 * sizeof(Vector3));
+            mesh.normals = (float*)MemAlloc(count * 3 * sizeof(Vector3));
+            mesh.colors = (unsigned char*)MemAlloc(count * 3 * sizeof(Color));
+            BoundingBox box = EmptyBox();
+            for (int k = 0; k < count; k++) {
+                int t = list[first + k];
+                std::memcpy(mesh.vertices + 9 * k, &positions[3 * t], 3 * sizeof(Vector3));
+                std::memcpy(mesh.normals + 9 * k, &normals[3 * t], 3 * sizeof(Vector3));
+                std::memcpy(mesh.colors + 12 * k, &colors[3 * t], 3 * sizeof(Color));
+                for (int c = 0; c < 3; c++) Enclose(box, positions[3 * t + c]);
+            }
+            UploadMesh(&mesh, false);
+            meshes.push_back(mesh);
+            meshBounds.push_back(box);
+            Enclose(bounds, box.min);
+            Enclose(bounds, box.max);
+        }
+    }
+    if (meshes.empty()) bounds = BoundingBox();
+
+    material = LoadMaterialDefault();
+    loaded = true;
+}
+
+void BakedGeometry::Unload() {
+    if (!loaded) return;
+    for (Mesh& mesh : meshes) UnloadMesh(mesh);
+    meshes.clear();
+    meshBounds.clear();
+    UnloadMaterial(material);
+    material = Material();
+    bounds = BoundingBox();
+    loaded = false;
+}
+
+int BakedGeometry::GetTriangleCount() const {
+    int count = 0;
+    for (const Mesh& mesh : meshes) count += mesh.triangleCount;
+    return count;
+}
+
+void BakedGeometry::Draw(const Frustum& view) const {
+    if (!loaded) return;
+    Matrix identity = MatrixIdentity();
+    for (size_t m = 0; m < meshes.size(); m++) {
+        if (view.IntersectsBox(meshBounds[m])) DrawMesh(meshes[m], material, identity);
+    }
+}
+
+void BakedGeometry::DrawInstanced(const std::vector<Matrix>& transforms, const Material& instancing, bool instanced) const {
+    if (!loaded || transforms.empty()) return;
+    for (const Mesh& mesh : meshes) {
+        if (instanced) {
+            DrawMeshInstanced(mesh, instancing, transforms.data(), (int)transforms.size());
+        } else {
+            for (const Matrix& t : transforms) DrawMesh(mesh, material, t);
+        }
+    }
+}
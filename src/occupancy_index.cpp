@@ -0,0 +1,44 @@
+#include "occupancy_index.h"
+#include "vehicle_pool.h"
+#include "raymath.h"
+#include <algorithm>
+
+OccupancyIndex::OccupancyIndex(float radius) : radius(radius), zoneGrid(radius) {}
+
+void OccupancyIndex::AddZone(const RoadGraph& graph, int nodeIndex) {
+    if (nodeIndex < 0 || zoneOfNode[nodeIndex] >= 0) return;
+    zoneOfNode[nodeIndex] = (int)zoneCenters.size();
+    zoneCenters.push_back(graph.PositionOf(nodeIndex));
+}
+
+void OccupancyIndex::Watch(const RoadGraph& graph, const std::vector<int>& extraNodeIds) {
+    zoneOfNode.assign(graph.GetNodeCount(), -1);
+    zoneCenters.clear();
+
+    // Entry points: spawn nodes and the landing node of every teleport
+    for (int i = 0; i < graph.GetNodeCount(); i++) {
+        if (graph.TypeOf(i) == START) AddZone(graph, i);
+        if (graph.TypeOf(i) == TELEPORT) AddZone(graph, graph.TeleportTargetOf(i));
+    }
+    for (int id : extraNodeIds) AddZone(graph, graph.IndexOf(id));
+
+    counts.assign(zoneCenters.size(), 0);
+    zoneGrid.Build(zoneCenters);
+}
+
+void OccupancyIndex::Update(const VehiclePool& vehicles) {
+    std::fill(counts.begin(), counts.end(), 0);
+
+    const VehicleKinematics& k = vehicles.GetKinematics();
+    for (size_t i = 0; i < k.Size(); i++) {
+        Vector3 position = k.Position(i);
+        zoneGrid.ForEachNear(position, radius, [&](int zone) {
+            if (Vector3Distance(position, zoneCenters[zone]) < radius) counts[zone]++;
+        });
+    }
+}
+
+void OccupancyIndex::MarkArrival(int nodeIndex) {
+    int zone = zoneOfNode[nodeIndex];
+    if (zone >= 0) counts[zone]++;
+}
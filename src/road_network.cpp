@@ -0,0 +1,263 @@
+#include "road_network.h"
+#include <cmath>
+
+// --- Returns {firstNodeID, lastNodeID} ---
+std::pair<int, int> addArcPath(RoadGraph& graph, Vector3 center, float radius, float startAngle, float endAngle, int segments) {
+    int startIdx = graph.GetAllNodes().size();
+    float step = (endAngle - startAngle) / segments;
+
+    for (int i = 0; i <= segments; i++) {
+        float angle = (startAngle + i * step) * DEG2RAD;
+        Vector3 pos = {
+            center.x + cosf(angle) * radius,
+            0.0f,
+            center.z + sinf(angle) * radius
+        };
+
+        int id = graph.GetAllNodes().size();
+        // 1. Initially set every node to ARC type
+        graph.AddNode(id, pos, ARC);
+
+        // Automatic internal chaining
+        if (i > 0) {
+            graph.ConnectNodes(id - 1, id);
+        }
+    }
+
+    int endIdx = graph.GetAllNodes().size() - 1;
+    
+    // 2. OVERRIDE: Set the Entry and Exit as DECISION nodes
+    graph.GetNode(startIdx).type = DECISION;
+    graph.GetNode(endIdx).type = DECISION;
+
+    return {startIdx, endIdx};
+}
+
+// --- Graph Building (Nodes & Connections) ---
+void InitializeRoadNetwork(RoadGraph& graph) {
+
+    // 1. Définition des Noeuds simples -------------------------------------------
+    graph.AddNode( 0, { -120.0f,   0.0f,   6.75f },     START);
+    graph.AddNode( 1, { -120.0f,   0.0f,   2.50f },     START);
+
+    graph.AddNode( 2, {  -40.0f,   0.0f,   6.75f },  DECISION);  // Enter Roundabout
+    graph.AddNode( 3, {  -40.0f,   0.0f,   2.50f },  DECISION);
+
+    graph.AddNode( 4, {  -6.75f,   0.0f,   40.0f },  DECISION);  // Exit Roundabout
+    graph.AddNode( 5, {  -2.50f,   0.0f,   40.0f },  DECISION);
+
+    graph.AddNode( 6, {  -6.75f,   0.0f,  120.0f },  TELEPORT);
+    graph.AddNode( 7, {  -2.50f,   0.0f,  120.0f },  TELEPORT);
+
+    graph.AddNode( 8, {   40.0f,   0.0f,  -6.75f },  DECISION);  // Enter Roundabout
+    graph.AddNode( 9, {   40.0f,   0.0f,  -2.50f },  DECISION);
+
+    graph.AddNode(10, {   6.75f,   0.0f,  -40.0f },  DECISION);  // Exit Roundabout
+    graph.AddNode(11, {   2.50f,   0.0f,  -40.0f },  DECISION);
+    
+    graph.AddNode(12, {  -6.75f,   0.0f,  -40.0f },  DECISION);  // Enter Roundabout
+    graph.AddNode(13, {  -2.50f,   0.0f,  -40.0f },  DECISION);
+
+    graph.AddNode(14, {  -40.0f,   0.0f,  -6.75f },  DECISION);  // Exit Roundabout
+    graph.AddNode(15, {  -40.0f,   0.0f,  -2.50f },  DECISION);
+
+    graph.AddNode(16, {   6.75f,   0.0f,   40.0f },  DECISION);  // Enter Roundabout
+    graph.AddNode(17, {   2.50f,   0.0f,   40.0f },  DECISION);
+
+    graph.AddNode(18, {   40.0f,   0.0f,   6.75f },  DECISION);  // Exit Roundabout
+    graph.AddNode(19, {   40.0f,   0.0f,   2.50f },  DECISION);
+
+    graph.AddNode(20, {  -87.5f,   0.0f,   6.75f },  DECISION);
+    graph.AddNode(21, {  -82.5f,   0.0f,   6.75f },  DECISION);
+    
+    graph.AddNode(22, {  -87.5f,   0.0f,   87.5f },  DECISION);
+    graph.AddNode(23, {  -82.5f,   0.0f,   82.5f },  DECISION);
+    
+    graph.AddNode(24, {  -6.75f,   0.0f,   87.5f },  DECISION);
+    graph.AddNode(25, {  -6.75f,   0.0f,   82.5f },  DECISION);
+    
+    graph.AddNode(26, {   6.75f,   0.0f,   120.0f},     START);
+    graph.AddNode(27, {   2.50f,   0.0f,   120.0f},     START);
+    
+    graph.AddNode(28, {   6.75f,   0.0f,  -120.0f},  TELEPORT);
+    graph.AddNode(29, {   2.50f,   0.0f,  -120.0f},  TELEPORT);
+    
+    graph.AddNode(30, {  -6.75f,   0.0f,  -120.0f},     START);
+    graph.AddNode(31, {  -2.50f,   0.0f,  -120.0f},     START);
+    
+    graph.AddNode(32, {   6.75f,   0.0f,   87.5f },  DECISION);
+    graph.AddNode(33, {   6.75f,   0.0f,   82.5f },  DECISION);
+    
+    graph.AddNode(34, {  100.0f,   0.0f,   87.5f },  TELEPORT);
+    graph.AddNode(35, {  100.0f,   0.0f,   82.5f },     START);
+    
+    graph.AddNode(36, {  106.5f,   0.0f,   6.75f },  DECISION);  // Enter Terminal Roundabout
+    graph.AddNode(37, {  109.0f,   0.0f,   2.50f },  DECISION);
+    
+    graph.AddNode(38, {  106.5f,   0.0f,  -6.75f },  DECISION);  // Exit Terminal Roundabout
+    graph.AddNode(39, {  109.0f,   0.0f,  -2.50f },  DECISION);
+    
+    graph.AddNode(40, {  -6.75f,   0.0f,   -87.5f},  DECISION);
+    graph.AddNode(41, {  -6.75f,   0.0f,   -82.5f},  DECISION);
+    
+    graph.AddNode(42, {   6.75f,   0.0f,   -87.5f},  DECISION);
+    graph.AddNode(43, {   6.75f,   0.0f,   -82.5f},  DECISION);
+    
+    graph.AddNode(44, { -120.0f,   0.0f,   -6.75f},  TELEPORT);
+    graph.AddNode(45, { -120.0f,   0.0f,   -2.50f},  TELEPORT);
+    
+    graph.AddNode(46, {  -87.5f,   0.0f,  -6.75f },  DECISION);
+    graph.AddNode(47, {  -82.5f,   0.0f,  -6.75f },  DECISION);
+    
+    graph.AddNode(48, {  -87.5f,   0.0f,  -87.5f },  DECISION);
+    graph.AddNode(49, {  -82.5f,   0.0f,  -82.5f },  DECISION);
+    
+    graph.AddNode(50, {  100.0f,   0.0f,  -87.5f },     START);
+    graph.AddNode(51, {  100.0f,   0.0f,  -82.5f },  TELEPORT);
+
+    // 2. Création des ARCS -------------------------------------------------------------
+    // --- Line 1 ---
+    auto arc2_1   = addArcPath(graph, {     -39, 0.0f,     39}, 32.25f,  -90.0f, -45.0f,  10);
+    auto arc2_2   = addArcPath(graph, {     -39, 0.0f,     39}, 32.25f,  -45.0f,   0.0f,  10);
+    auto arc3_1   = addArcPath(graph, {  -34.25, 0.0f,  34.25}, 31.75f,  -90.0f, -45.0f,  10);
+    auto arc3_2   = addArcPath(graph, {  -34.25, 0.0f,  34.25}, 31.75f,  -45.0f,   0.0f,  10);
+
+    // --- Line 2 ---
+    auto arc16_1  = addArcPath(graph, {      39, 0.0f,     39}, 32.25f, -180.0f, -135.0f, 10);
+    auto arc16_2  = addArcPath(graph, {      39, 0.0f,     39}, 32.25f, -135.0f,  -90.0f, 10);
+    auto arc17_1  = addArcPath(graph, {   34.25, 0.0f,  34.25}, 31.75f, -180.0f, -135.0f, 10);
+    auto arc17_2  = addArcPath(graph, {   34.25, 0.0f,  34.25}, 31.75f, -135.0f,  -90.0f, 10);
+    
+    // --- Line 3 ---
+    auto arc8_1   = addArcPath(graph, {      39, 0.0f,    -39}, 32.25f, -270.0f, -225.0f, 10);
+    auto arc8_2   = addArcPath(graph, {      39, 0.0f,    -39}, 32.25f, -225.0f, -180.0f, 10);
+    auto arc9_1   = addArcPath(graph, {   34.25, 0.0f, -34.25}, 31.75f, -270.0f, -225.0f, 10);
+    auto arc9_2   = addArcPath(graph, {   34.25, 0.0f, -34.25}, 31.75f, -225.0f, -180.0f, 10);   
+
+    // --- Line 4 ---
+    auto arc12_1  = addArcPath(graph, {     -39, 0.0f,    -39}, 32.25f, -360.0f, -315.0f, 10);
+    auto arc12_2  = addArcPath(graph, {     -39, 0.0f,    -39}, 32.25f, -315.0f, -270.0f, 10);
+    auto arc13_1  = addArcPath(graph, {  -34.25, 0.0f, -34.25}, 31.75f, -360.0f, -315.0f, 10);
+    auto arc13_2  = addArcPath(graph, {  -34.25, 0.0f, -34.25}, 31.75f, -315.0f, -270.0f, 10);
+    
+    // --- Main Roundabout ---
+    auto arc_r1_1 = addArcPath(graph, {    0.0f, 0.0f,   0.0f}, 16.75f,  135.0f,   45.0f, 15); // Line 1
+    auto arc_r1_2 = addArcPath(graph, {    0.0f, 0.0f,   0.0f}, 23.00f,  135.0f,   45.0f, 15);
+    auto arc_r2_1 = addArcPath(graph, {    0.0f, 0.0f,   0.0f}, 16.75f,   45.0f,  -45.0f, 15); // Line 2
+    auto arc_r2_2 = addArcPath(graph, {    0.0f, 0.0f,   0.0f}, 23.00f,   45.0f,  -45.0f, 15);
+    auto arc_r3_1 = addArcPath(graph, {    0.0f, 0.0f,   0.0f}, 16.75f,  -45.0f, -135.0f, 15); // Line 3
+    auto arc_r3_2 = addArcPath(graph, {    0.0f, 0.0f,   0.0f}, 23.00f,  -45.0f, -135.0f, 15);
+    auto arc_r4_1 = addArcPath(graph, {    0.0f, 0.0f,   0.0f}, 16.75f, -135.0f, -225.0f, 15); // Line 4
+    auto arc_r4_2 = addArcPath(graph, {    0.0f, 0.0f,   0.0f}, 23.00f, -135.0f, -225.0f, 15);
+
+    // --- Terminal Roundabout ---
+    auto arc_tr37 = addArcPath(graph, { 120.25f, 0.0f,   0.0f},  10.5f,  160.0f, -160.0f, 15);
+    auto arc_tr36 = addArcPath(graph, { 120.50f, 0.0f,   0.0f},  14.0f,  150.0f, -150.0f, 15);
+
+
+    // 3. CONNEXIONS (Utilisation de ConnectNodes) ----------------------------------------------------------------
+    graph.ConnectNodes( 0, 20);
+    graph.ConnectNodes(20, 22); graph.ConnectNodes(20,  2);
+    graph.ConnectNodes(22, 24); graph.ConnectNodes(24,  6);
+    graph.ConnectNodes( 4, 25);
+    graph.ConnectNodes(25,  6); graph.ConnectNodes(25, 23);
+    graph.ConnectNodes(23, 21); graph.ConnectNodes(21,  2);
+    graph.ConnectNodes( 1,  3); graph.ConnectNodes( 5,  7);
+    graph.ConnectNodes(27, 17); graph.ConnectNodes(26, 32);
+    graph.ConnectNodes(32, 16); graph.ConnectNodes(32, 34);
+    graph.ConnectNodes(35, 33); graph.ConnectNodes(33, 16);
+    graph.ConnectNodes(18, 36); graph.ConnectNodes(19, 37);
+    graph.ConnectNodes(39,  9); graph.ConnectNodes(38,  8);
+    graph.ConnectNodes(11, 29); graph.ConnectNodes(10, 43);
+    graph.ConnectNodes(43, 51); graph.ConnectNodes(43, 28);
+    graph.ConnectNodes(50, 42); graph.ConnectNodes(42, 28);
+    graph.ConnectNodes(31, 13); graph.ConnectNodes(30, 40);
+    graph.ConnectNodes(40, 12); graph.ConnectNodes(40, 48);
+    graph.ConnectNodes(48, 46); graph.ConnectNodes(46, 44);
+    graph.ConnectNodes(15, 45); graph.ConnectNodes(14, 47);
+    graph.ConnectNodes(47, 44); graph.ConnectNodes(47, 49);
+    graph.ConnectNodes(49, 41); graph.ConnectNodes(41, 12);
+
+    // 4. CONNEXIONS DES ARC -----------------------------------------------------------------------------
+    // --- Line 1 ---
+    graph.ConnectNodes(2, arc2_1.first);
+    graph.ConnectNodes(arc2_1.second, arc2_2.first);
+    graph.ConnectNodes(arc2_2.second, 4);
+    graph.ConnectNodes(3, arc3_1.first);
+    graph.ConnectNodes(arc3_1.second, arc3_2.first);
+    graph.ConnectNodes(arc3_2.second, 5);
+
+    // --- Line 2 ---
+    graph.ConnectNodes(16, arc16_1.first);
+    graph.ConnectNodes(arc16_1.second, arc16_2.first);
+    graph.ConnectNodes(arc16_2.second, 18);
+    graph.ConnectNodes(17, arc17_1.first);
+    graph.ConnectNodes(arc17_1.second, arc17_2.first);
+    graph.ConnectNodes(arc17_2.second, 19);
+
+    // --- Line 3 ---
+    graph.ConnectNodes(8, arc8_1.first);
+    graph.ConnectNodes(arc8_1.second, arc8_2.first);
+    graph.ConnectNodes(arc8_2.second, 10);
+    graph.ConnectNodes(9, arc9_1.first);
+    graph.ConnectNodes(arc9_1.second, arc9_2.first);
+    graph.ConnectNodes(arc9_2.second, 11);
+
+    // --- Line 4 ---
+    graph.ConnectNodes(12, arc12_1.first);
+    graph.ConnectNodes(arc12_1.second, arc12_2.first);
+    graph.ConnectNodes(arc12_2.second, 14);
+    graph.ConnectNodes(13, arc13_1.first);
+    graph.ConnectNodes(arc13_1.second, arc13_2.first);
+    graph.ConnectNodes(arc13_2.second, 15);
+
+    // --- Main Roundabout ---
+        // PART 1:
+        graph.ConnectNodes(arc2_1.second, arc_r1_2.first);
+        graph.ConnectNodes(arc_r1_2.second, arc16_2.first);
+        graph.ConnectNodes(arc_r1_2.second, arc_r2_2.first);
+        graph.ConnectNodes(arc3_1.second, arc_r1_1.first);
+        graph.ConnectNodes(arc_r1_1.second, arc17_2.first);
+        graph.ConnectNodes(arc_r1_1.second, arc_r2_1.first);
+        // PART 2:
+        graph.ConnectNodes(arc16_1.second, arc_r2_2.first);
+        graph.ConnectNodes(arc_r2_2.second, arc8_2.first);
+        graph.ConnectNodes(arc_r2_2.second, arc_r3_2.first);
+        graph.ConnectNodes(arc17_1.second, arc_r2_1.first);
+        graph.ConnectNodes(arc_r2_1.second, arc9_2.first);
+        graph.ConnectNodes(arc_r2_1.second, arc_r3_1.first);
+        // PART 3:
+        graph.ConnectNodes(arc8_1.second, arc_r3_2.first);
+        graph.ConnectNodes(arc_r3_2.second, arc12_2.first);
+        graph.ConnectNodes(arc_r3_2.second, arc_r4_2.first);
+        graph.ConnectNodes(arc9_1.second, arc_r3_1.first);
+        graph.ConnectNodes(arc_r3_1.second, arc13_2.first);
+        graph.ConnectNodes(arc_r3_1.second, arc_r4_1.first);
+        // PART 4:
+        graph.ConnectNodes(arc12_1.second, arc_r4_2.first);
+        graph.ConnectNodes(arc_r4_2.second, arc2_2.first);
+        graph.ConnectNodes(arc_r4_2.second, arc_r1_2.first);
+        graph.ConnectNodes(arc13_1.second, arc_r4_1.first);
+        graph.ConnectNodes(arc_r4_1.second, arc3_2.first);
+        graph.ConnectNodes(arc_r4_1.second, arc_r1_1.first);
+    
+    // --- Terminal Roundabout ---
+    graph.ConnectNodes(36, arc_tr36.first);
+    graph.ConnectNodes(arc_tr36.second, 38);
+    graph.ConnectNodes(37, arc_tr37.first);
+    graph.ConnectNodes(arc_tr37.second, 39);
+    
+    // 5. TELEPORTS (Utilisation de SetTeleportTarget)
+    graph.SetTeleportTarget( 6, 30);
+    graph.SetTeleportTarget( 7, 31);
+    graph.SetTeleportTarget(29, 26);
+    graph.SetTeleportTarget(28, 27);
+    graph.SetTeleportTarget(44, 50);
+    graph.SetTeleportTarget(45, 35);
+    graph.SetTeleportTarget(34,  0);
+    graph.SetTeleportTarget(51,  1);
+
+    // 6. FREEZE THE GRAPH (Flat arrays used by the simulation)
+    graph.Finalize();
+
+}
@@ -1,30 +1,50 @@
 #include "roadgraph.h"
 #include "config.h" // Pour utiliser les couleurs centralisées
+#include <string>
 
 RoadGraph::RoadGraph() {}
 RoadGraph::~RoadGraph() {}
 
+int RoadGraph::FindIndex(int id) const {
+    if (id < 0 || id >= (int)indexById.size()) return -1;
+    return indexById[id];
+}
+
+int RoadGraph::NodeIndex(int id) const {
+    int index = FindIndex(id);
+    if (index < 0) throw std::out_of_range("RoadGraph: unknown node id " + std::to_string(id));
+    return index;
+}
+
+int RoadGraph::IndexOf(int id) const {
+    if (!finalized) throw std::logic_error("RoadGraph: not finalized (node id " + std::to_string(id) + ")");
+    return NodeIndex(id);
+}
+
 void RoadGraph::AddNode(int id, Vector3 pos, NodeType type) {
+    if (id < 0) throw std::out_of_range("RoadGraph: negative node id " + std::to_string(id));
+    if (FindIndex(id) >= 0) throw std::invalid_argument("RoadGraph: duplicate node id " + std::to_string(id));
+
+    if (id >= (int)indexById.size()) indexById.resize(id + 1, -1);
+    indexById[id] = (int)nodes.size();
+
     Node newNode(id, pos, type);
     nodes.push_back(newNode);
+    DropFinalized();
 }
 
 void RoadGraph::ConnectNodes(int fromId, int toId) {
-    // On cherche le nœud source par son ID pour ajouter la connexion
-    for (auto& node : nodes) {
-        if (node.id == fromId) {
-            node.nextNodes.push_back(toId);
-            break;
-        }
-    }
+    // La destination peut être ajoutée plus tard: elle est vérifiée par Finalize()
+    nodes[NodeIndex(fromId)].nextNodes.push_back(toId);
+    DropFinalized();
 }
 
 Node& RoadGraph::GetNode(int id) {
-    // Recherche sécurisée de l'ID
-    for (auto& node : nodes) {
-        if (node.id == id) return node;
-    }
-    return nodes[0]; // Sécurité par défaut
+    return nodes[NodeIndex(id)];
+}
+
+const Node& RoadGraph::GetNode(int id) const {
+    return nodes[NodeIndex(id)];
 }
 
 const std::vector<Node>& RoadGraph::GetAllNodes() const {
@@ -32,65 +52,64 @@ const std::vector<Node>& RoadGraph::GetAllNodes() const {
 }
 
 void RoadGraph::SetTeleportTarget(int nodeId, int targetId) {
-    for (auto& node : nodes) {
-        if (node.id == nodeId) {
-            node.teleportTargetId = targetId;
-            break;
-        }
-    }
+    nodes[NodeIndex(nodeId)].teleportTargetId = targetId;
+    DropFinalized();
 }
 
-void RoadGraph::Clear() {
-    nodes.clear();
-}
+void RoadGraph::Finalize() {
+    size_t count = nodes.size();
+    size_t edgeCount = 0;
+    for (const auto& node : nodes) edgeCount += node.nextNodes.size();
 
-void RoadGraph::DrawNodes() {
-    
-    for (const auto& n : nodes) {
-        // --- DESSIN DES SPHÈRES ---
-        // ONLY draw the sphere if it is NOT an ARC node
-        if (n.type != ARC) {
-            Color nodeColor = (n.type == START) ? GREEN : (n.type == TELEPORT ? RED : YELLOW);
-            DrawSphere(n.pos, 1.0f, nodeColor);
-        }
+    ids.resize(count);
+    positions.resize(count);
+    types.resize(count);
+    teleportTargets.resize(count);
+    edgeOffsets.resize(count + 1);
+    adjacency.clear();
+    adjacency.reserve(edgeCount);
 
-        // --- DESSIN DES LIGNES DE CONNEXION ---
-        for (int nextId : n.nextNodes) {
-            
-            Vector3 nextPos = GetNode(nextId).pos;
-
-            // Draw a line from the current node to its destination
-            DrawLine3D(
-                { n.pos.x, n.pos.y + 0.5f, n.pos.z }, 
-                { nextPos.x, nextPos.y + 0.5f, nextPos.z }, 
-                YELLOW
-            );
+    try {
+        for (size_t i = 0; i < count; i++) {
+            const Node& node = nodes[i];
+            ids[i] = node.id;
+            positions[i] = node.pos;
+            types[i] = node.type;
+            teleportTargets[i] = (node.teleportTargetId >= 0) ? NodeIndex(node.teleportTargetId) : -1;
+
+            edgeOffsets[i] = (int)adjacency.size();
+            for (int nextId : node.nextNodes) {
+                adjacency.push_back(NodeIndex(nextId));
+            }
         }
+    } catch (...) {
+        DropFinalized(); // No half-built CSR left behind
+        throw;
     }
+    edgeOffsets[count] = (int)adjacency.size();
+    finalized = true;
 }
 
-void RoadGraph::DrawIdNodes(Camera3D camera) {
-     
-    // Cette partie doit techniquement être appelée quand on est en mode 2D, 
-    // mais Raylib permet GetWorldToScreen pour projeter les IDs.
-    
-    for (const auto& n : nodes) {
-        if (n.type != ARC) {
-
-            // Convert 3D position to 2D screen position
-            //.-.
-            Vector2 screenPos = GetWorldToScreen({n.pos.x, n.pos.y + 2.5f, n.pos.z}, camera);
-            float scaleX = (float)SimulationConfig::SCREEN_WIDTH / GetScreenWidth();
-            float scaleY = (float)SimulationConfig::SCREEN_HEIGHT / GetScreenHeight();
-            
-            screenPos.x *= scaleX;
-            screenPos.y *= scaleY;
-            //._. end
-
-            // Only draw if the node is actually in front of the camera
-            if (screenPos.x > 0 && screenPos.y > 0) {
-                DrawText(TextFormat("ID:%d", n.id), screenPos.x - 10, screenPos.y, 10, BLACK);
-            }
-        }
+void RoadGraph::DropFinalized() {
+    // Emptied, not just flagged: the CSR accessors never read arrays older than the nodes
+    ids.clear();
+    positions.clear();
+    types.clear();
+    teleportTargets.clear();
+    edgeOffsets.clear();
+    adjacency.clear();
+    finalized = false;
+}
+
+int RoadGraph::FindEdge(int fromIndex, int toIndex) const {
+    for (int e = edgeOffsets[fromIndex]; e < edgeOffsets[fromIndex + 1]; e++) {
+        if (adjacency[e] == toIndex) return e;
     }
-}
\ No newline at end of file
+    return -1;
+}
+
+void RoadGraph::Clear() {
+    nodes.clear();
+    indexById.clear();
+    DropFinalized();
+}
@@ -0,0 +1,63 @@
+#include "roadgraph.h"
+#include "config.h"
+#include "frustum.h"
+#include "raymath.h"
+
+// Debug rendering of the graph (not part of the headless core)
+
+void RoadGraph::DrawNodes(const Frustum& view) const {
+    
+    for (int i = 0; i < GetNodeCount(); i++) {
+        Vector3 pos = positions[i];
+        NodeType type = types[i];
+
+        // --- DESSIN DES SPHÈRES ---
+        // ONLY draw the sphere if it is NOT an ARC node
+        if (type != ARC && view.IntersectsSphere(pos, 1.0f)) {
+            Color nodeColor = (type == START) ? GREEN : (type == TELEPORT ? RED : YELLOW);
+            DrawSphere(pos, 1.0f, nodeColor);
+        }
+
+        // --- DESSIN DES LIGNES DE CONNEXION ---
+        for (int next : Successors(i)) {
+            
+            Vector3 nextPos = positions[next];
+            BoundingBox span = { Vector3Min(pos, nextPos), Vector3Max(pos, nextPos) };
+            span.max.y += 0.5f;
+            if (!view.IntersectsBox(span)) continue;
+
+            // Draw a line from the current node to its destination
+            DrawLine3D(
+                { pos.x, pos.y + 0.5f, pos.z }, 
+                { nextPos.x, nextPos.y + 0.5f, nextPos.z }, 
+                YELLOW
+            );
+        }
+    }
+}
+
+void RoadGraph::DrawIdNodes(Camera3D camera, const Frustum& view) const {
+     
+    // Cette partie doit techniquement être appelée quand on est en mode 2D, 
+    // mais Raylib permet GetWorldToScreen pour projeter les IDs.
+    
+    for (const auto& n : nodes) {
+        if (n.type != ARC) {
+            // Only labels in view (same culling as the 3D pass; also drops those behind the camera)
+            Vector3 labelPos = {n.pos.x, n.pos.y + 2.5f, n.pos.z};
+            if (!view.ContainsPoint(labelPos)) continue;
+
+            // Convert 3D position to 2D screen position
+            //.-.
+            Vector2 screenPos = GetWorldToScreen(labelPos, camera);
+            float scaleX = (float)SimulationConfig::SCREEN_WIDTH / GetScreenWidth();
+            float scaleY = (float)SimulationConfig::SCREEN_HEIGHT / GetScreenHeight();
+            
+            screenPos.x *= scaleX;
+            screenPos.y *= scaleY;
+            //._. end
+
+            DrawText(TextFormat("ID:%d", n.id), screenPos.x - 10, screenPos.y, 10, BLACK);
+        }
+    }
+}
\ No newline at end of file
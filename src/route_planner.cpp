@@ -0,0 +1,398 @@
+#include "route_planner.h"
+#include "job_system.h"
+#include "sim_random.h"
+#include "raymath.h"
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+typedef std::pair<float, int> QueueEntry; // (cost, node), smallest cost first
+typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> MinQueue;
+
+// =============================================================================
+//  SHORTEST PATH TREE
+// =============================================================================
+
+void ShortestPathTree::PathFrom(int origin, std::vector<int>& path) const {
+    path.clear();
+    if (!Reaches(origin)) return;
+    for (int node = origin; node >= 0; node = next[node]) path.push_back(node);
+}
+
+// =============================================================================
+//  SETUP
+// =============================================================================
+
+float RoutePlanner::EdgeLength(int edge, int from) const {
+    int to = graph->Successors(from)[edge - graph->FirstEdge(from)];
+    return Vector3Distance(graph->PositionOf(from), graph->PositionOf(to));
+}
+
+void RoutePlanner::Build(const RoadGraph& g) {
+    graph = &g;
+    int count = g.GetNodeCount();
+
+    // Reverse CSR (counting sort of the edges by target)
+    reverseOffsets.assign(count + 1, 0);
+    for (int from = 0; from < count; from++) {
+        for (int to : g.Successors(from)) reverseOffsets[to + 1]++;
+    }
+    for (int v = 0; v < count; v++) reverseOffsets[v + 1] += reverseOffsets[v];
+    reverseFrom.assign(g.GetEdgeCount(), 0);
+    reverseEdge.assign(g.GetEdgeCount(), 0);
+    edgeFrom.assign(g.GetEdgeCount(), 0);
+    std::vector<int> fill(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for (int from = 0; from < count; from++) {
+        NodeRange next = g.Successors(from);
+        for (int k = 0; k < next.size(); k++) {
+            int slot = fill[next[k]]++;
+            reverseFrom[slot] = from;
+            reverseEdge[slot] = g.FirstEdge(from) + k;
+            edgeFrom[g.FirstEdge(from) + k] = from;
+        }
+    }
+
+    // Default cost: length
+    std::vector<float> lengths(g.GetEdgeCount());
+    for (int from = 0; from < count; from++) {
+        for (int e = g.FirstEdge(from); e < g.FirstEdge(from) + g.Successors(from).size(); e++) {
+            lengths[e] = EdgeLength(e, from);
+        }
+    }
+    SetEdgeCosts(lengths);
+}
+
+void RoutePlanner::SetEdgeCosts(const std::vector<float>& costs) {
+    edgeCost = costs;
+
+    // Cheapest cost per meter keeps the A* heuristic admissible
+    costPerMeter = ROUTE_UNREACHABLE;
+    for (int from = 0; from < graph->GetNodeCount(); from++) {
+        for (int e = graph->FirstEdge(from); e < graph->FirstEdge(from) + graph->Successors(from).size(); e++) {
+            float length = EdgeLength(e, from);
+            if (length > 0.0f) costPerMeter = std::min(costPerMeter, edgeCost[e] / length);
+        }
+    }
+    if (costPerMeter == ROUTE_UNREACHABLE) costPerMeter = 0.0f;
+    ClearCache();
+}
+
+// =============================================================================
+//  QUERIES
+// =============================================================================
+
+bool RoutePlanner::FindRoute(int origin, int destination, std::vector<int>& path, float* cost) const {
+    path.clear();
+    int count = graph->GetNodeCount();
+    Vector3 goal = graph->PositionOf(destination);
+    auto heuristic = [&](int node) { return Vector3Distance(graph->PositionOf(node), goal) * costPerMeter; };
+
+    std::vector<float> best(count, ROUTE_UNREACHABLE);
+    std::vector<int> previous(count, -1);
+    MinQueue open;
+    best[origin] = 0.0f;
+    open.push({ heuristic(origin), origin });
+
+    while (!open.empty()) {
+        QueueEntry top = open.top();
+        open.pop();
+        int node = top.second;
+        if (node == destination) break;
+        if (top.first > best[node] + heuristic(node)) continue; // Stale entry
+        if (node != origin && graph->TypeOf(node) == TELEPORT) continue; // Vehicles jump away from here
+
+        int e = graph->FirstEdge(node);
+        for (int to : graph->Successors(node)) {
+            float c = best[node] + edgeCost[e++];
+            if (c < best[to]) {
+                best[to] = c;
+                previous[to] = node;
+                open.push({ c + heuristic(to), to });
+            }
+        }
+    }
+
+    if (best[destination] == ROUTE_UNREACHABLE) return false;
+    for (int node = destination; node >= 0; node = previous[node]) path.push_back(node);
+    std::reverse(path.begin(), path.end());
+    if (cost) *cost = best[destination];
+    return true;
+}
+
+void RoutePlanner::ComputeTree(int destination, ShortestPathTree& tree) const {
+    int count = graph->GetNodeCount();
+    tree.destination = destination;
+    tree.cost.assign(count, ROUTE_UNREACHABLE);
+    tree.next.assign(count, -1);
+
+    MinQueue open;
+    tree.cost[destination] = 0.0f;
+    open.push({ 0.0f, destination });
+    while (!open.empty()) {
+        QueueEntry top = open.top();
+        open.pop();
+        int node = top.second;
+        if (top.first > tree.cost[node]) continue; // Stale entry
+
+        for (int k = reverseOffsets[node]; k < reverseOffsets[node + 1]; k++) {
+            int from = reverseFrom[k];
+            if (graph->TypeOf(from) == TELEPORT) continue; // A route cannot pass a teleport
+            float c = tree.cost[node] + edgeCost[reverseEdge[k]];
+            if (c < tree.cost[from]) {
+                tree.cost[from] = c;
+                tree.next[from] = node;
+                open.push({ c, from });
+            }
+        }
+    }
+}
+
+// =============================================================================
+//  LRU CACHE
+// =============================================================================
+
+RoutePlanner::TreePtr RoutePlanner::Lookup(int destination) {
+    auto found = cached.find(destination);
+    if (found == cached.end()) {
+        cacheMisses++;
+        return nullptr;
+    }
+    cacheHits++;
+    lru.splice(lru.begin(), lru, found->second); // Now the most recent
+    return *found->second;
+}
+
+void RoutePlanner::Insert(const TreePtr& tree) {
+    if (cacheCapacity == 0 || cached.count(tree->destination)) return;
+    lru.push_front(tree);
+    cached[tree->destination] = lru.begin();
+    while (lru.size() > cacheCapacity) {
+        cached.erase(lru.back()->destination);
+        lru.pop_back();
+    }
+}
+
+std::shared_ptr<const ShortestPathTree> RoutePlanner::TreeTo(int destination) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        TreePtr tree = Lookup(destination);
+        if (tree) return tree;
+    }
+    // Built outside the lock: other destinations stay available meanwhile
+    std::shared_ptr<ShortestPathTree> tree = std::make_shared<ShortestPathTree>();
+    ComputeTree(destination, *tree);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    Insert(tree);
+    return tree;
+}
+
+void RoutePlanner::SetCacheCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cacheCapacity = capacity;
+    while (lru.size() > cacheCapacity) {
+        cached.erase(lru.back()->destination);
+        lru.pop_back();
+    }
+}
+
+void RoutePlanner::ClearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    lru.clear();
+    cached.clear();
+}
+
+size_t RoutePlanner::GetCachedTreeCount() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return lru.size();
+}
+
+long long RoutePlanner::GetCacheHits() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cacheHits;
+}
+
+long long RoutePlanner::GetCacheMisses() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cacheMisses;
+}
+
+// =============================================================================
+//  BATCH
+// =============================================================================
+
+void RoutePlanner::PlanBatch(const std::vector<RouteRequest>& requests, std::vector<std::vector<int>>& routes,
+                             JobSystem* jobs) {
+    // 1. One tree per distinct destination: cached ones, then the missing ones in parallel
+    std::vector<int> destinations;
+    std::unordered_map<int, int> slotOf;   // Destination -> index in 'trees'
+    for (const RouteRequest& r : requests) {
+        if (slotOf.emplace(r.destination, (int)destinations.size()).second) destinations.push_back(r.destination);
+    }
+
+    // Kept here for the whole batch, even if the cache is smaller than the batch
+    std::vector<TreePtr> trees(destinations.size());
+    std::vector<int> missing;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        for (size_t d = 0; d < destinations.size(); d++) {
+            trees[d] = Lookup(destinations[d]);
+            if (!trees[d]) missing.push_back((int)d);
+        }
+    }
+
+    std::vector<int> missingDestinations;
+    for (int m : missing) missingDestinations.push_back(destinations[m]);
+    std::vector<std::shared_ptr<ShortestPathTree>> built;
+    ComputeTrees(missingDestinations, built, jobs);
+    for (size_t m = 0; m < missing.size(); m++) trees[missing[m]] = built[m];
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        for (int m : missing) Insert(trees[m]);
+    }
+
+    // 2. Paths: each request only reads its tree and writes its own route
+    routes.resize(requests.size());
+    auto extract = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            trees[slotOf.at(requests[i].destination)]->PathFrom(requests[i].origin, routes[i]);
+        }
+    };
+    const size_t grain = 256;
+    if (jobs) jobs->ParallelFor(requests.size(), grain, extract);
+    else extract(0, requests.size());
+}
+
+void RoutePlanner::ComputeTrees(const std::vector<int>& destinations, std::vector<std::shared_ptr<ShortestPathTree>>& trees,
+                                JobSystem* jobs) const {
+    trees.resize(destinations.size());
+    auto build = [&](size_t begin, size_t end) {
+        for (size_t d = begin; d < end; d++) {
+            trees[d] = std::make_shared<ShortestPathTree>();
+            ComputeTree(destinations[d], *trees[d]);
+        }
+    };
+    if (jobs) jobs->ParallelFor(destinations.size(), 1, build);
+    else build(0, destinations.size());
+}
+
+// =============================================================================
+//  INCREMENTAL UPDATES
+// =============================================================================
+
+std::vector<RoutePlanner::EdgeChange> RoutePlanner::UpdateEdgeCosts(const std::vector<float>& costs, float tolerance) {
+    std::vector<EdgeChange> changes;
+    for (size_t e = 0; e < costs.size(); e++) {
+        float old = edgeCost[e];
+        if (fabsf(costs[e] - old) <= tolerance * old) continue;
+        changes.push_back({ (int)e, old, costs[e] });
+        edgeCost[e] = costs[e];
+        // Only a cheaper edge can lower the heuristic factor (a higher factor would still be admissible, just looser)
+        float length = EdgeLength((int)e, edgeFrom[e]);
+        if (length > 0.0f) costPerMeter = std::min(costPerMeter, costs[e] / length);
+    }
+    if (!changes.empty()) ClearCache();
+    return changes;
+}
+
+int RoutePlanner::RepairTree(ShortestPathTree& tree, const std::vector<EdgeChange>& changes) const {
+    const int AFFECTED = -2;   // Temporary 'next' of the nodes to recompute
+    MinQueue open;
+    int visited = 0;
+
+    // 1. Costlier edges on the tree: every node routed through one of them is recomputed
+    std::vector<int> affected;
+    std::vector<int> stack;
+    for (const EdgeChange& c : changes) {
+        int from = edgeFrom[c.edge];
+        int to = graph->Successors(from)[c.edge - graph->FirstEdge(from)];
+        if (c.newCost <= c.oldCost || tree.next[from] != to) continue;
+        stack.push_back(from);
+        while (!stack.empty()) {
+            int node = stack.back();
+            stack.pop_back();
+            if (tree.next[node] == AFFECTED) continue;
+            // Children: the nodes whose next node is this one (still intact at this point)
+            for (int k = reverseOffsets[node]; k < reverseOffsets[node + 1]; k++) {
+                if (tree.next[reverseFrom[k]] == node) stack.push_back(reverseFrom[k]);
+            }
+            tree.next[node] = AFFECTED;
+            affected.push_back(node);
+        }
+    }
+    // Best exit from each affected node towards the rest of the tree (still valid), then settled below
+    std::vector<QueueEntry> exits(affected.size(), QueueEntry(ROUTE_UNREACHABLE, -1));
+    for (size_t a = 0; a < affected.size(); a++) {
+        int node = affected[a];
+        int e = graph->FirstEdge(node);
+        for (int to : graph->Successors(node)) {
+            float c = edgeCost[e++] + tree.cost[to];
+            if (tree.next[to] != AFFECTED && tree.cost[to] < ROUTE_UNREACHABLE && c < exits[a].first) exits[a] = { c, to };
+        }
+    }
+    for (size_t a = 0; a < affected.size(); a++) {
+        tree.cost[affected[a]] = exits[a].first;
+        tree.next[affected[a]] = exits[a].second;
+        if (exits[a].second >= 0) open.push({ exits[a].first, affected[a] });
+    }
+
+    // 2. Cheaper edges: only the nodes they improve
+    for (const EdgeChange& c : changes) {
+        int from = edgeFrom[c.edge];
+        int to = graph->Successors(from)[c.edge - graph->FirstEdge(from)];
+        if (c.newCost >= c.oldCost || graph->TypeOf(from) == TELEPORT || tree.cost[to] >= ROUTE_UNREACHABLE) continue;
+        float cost = tree.cost[to] + c.newCost;
+        if (cost < tree.cost[from]) {
+            tree.cost[from] = cost;
+            tree.next[from] = to;
+            open.push({ cost, from });
+        }
+    }
+
+    // 3. Dijkstra from the changed nodes only
+    while (!open.empty()) {
+        QueueEntry top = open.top();
+        open.pop();
+        int node = top.second;
+        if (top.first > tree.cost[node]) continue; // Stale entry
+        visited++;
+        for (int k = reverseOffsets[node]; k < reverseOffsets[node + 1]; k++) {
+            int from = reverseFrom[k];
+            if (graph->TypeOf(from) == TELEPORT) continue;
+            float c = tree.cost[node] + edgeCost[reverseEdge[k]];
+            if (c < tree.cost[from]) {
+                tree.cost[from] = c;
+                tree.next[from] = node;
+                open.push({ c, from });
+            }
+        }
+    }
+    return visited + (int)affected.size();
+}
+
+// =============================================================================
+//  ROUTE TABLE
+// =============================================================================
+
+void RouteTable::Clear(int nodeCount) {
+    trees.clear();
+    routesFrom.assign(nodeCount, std::vector<int>());
+}
+
+int RouteTable::Add(std::shared_ptr<const ShortestPathTree> tree) {
+    int id = GetRouteCount();
+    for (int node = 0; node < (int)routesFrom.size(); node++) {
+        if (tree->next[node] >= 0) routesFrom[node].push_back(id);
+    }
+    trees.push_back(std::move(tree));
+    return id;
+}
+
+int RouteTable::PickFrom(int origin, uint32_t& seed) const {
+    if (origin < 0 || origin >= (int)routesFrom.size() || routesFrom[origin].empty()) return -1;
+    const std::vector<int>& choices = routesFrom[origin];
+    SimRandom rng(seed);
+    int pick = choices[rng.Range(0, (int)choices.size() - 1)];
+    seed = rng.state;
+    return pick;
+}
@@ -0,0 +1,101 @@
+#include "route_refresher.h"
+#include <chrono>
+
+void RouteRefresher::Start(const RoadGraph& graph, const std::vector<int>& destinations, const std::vector<float>& costs,
+                           JobSystem* jobs) {
+    Stop();
+    nodeCount = graph.GetNodeCount();
+    planner.Build(graph);
+    planner.SetEdgeCosts(costs);
+    planner.ComputeTrees(destinations, trees, jobs);
+    Publish();
+
+    stopping = false;
+    hasJob = false;
+    busy = false;
+    refreshCount = 0;
+    repairedNodes = 0;
+    lastRefreshTime = 0.0;
+    worker = std::thread(&RouteRefresher::Run, this);
+}
+
+void RouteRefresher::Stop() {
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+void RouteRefresher::Submit(const std::vector<float>& costs) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingCosts = costs;
+        hasJob = true;
+    }
+    wake.notify_one();
+}
+
+void RouteRefresher::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return !hasJob && !busy; });
+}
+
+void RouteRefresher::Run() {
+    std::vector<float> costs;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            busy = false;
+            done.notify_all();
+            wake.wait(lock, [this]() { return hasJob || stopping; });
+            if (stopping) return;
+            costs.swap(pendingCosts);
+            hasJob = false;
+            busy = true;
+        }
+        Refresh(costs);
+    }
+}
+
+void RouteRefresher::Refresh(const std::vector<float>& costs) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<RoutePlanner::EdgeChange> changes = planner.UpdateEdgeCosts(costs, COST_TOLERANCE);
+    if (changes.empty()) return;
+
+    long long visited = 0;
+    for (const std::shared_ptr<ShortestPathTree>& tree : trees) visited += planner.RepairTree(*tree, changes);
+    Publish();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    refreshCount++;
+    repairedNodes += visited;
+    lastRefreshTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RouteRefresher::Publish() {
+    // Published trees are never touched again: the table gets copies
+    std::shared_ptr<RouteTable> table = std::make_shared<RouteTable>();
+    table->Clear(nodeCount);
+    for (const std::shared_ptr<ShortestPathTree>& tree : trees) {
+        table->Add(std::make_shared<const ShortestPathTree>(*tree));
+    }
+    std::atomic_store(&published, std::shared_ptr<const RouteTable>(std::move(table)));
+}
+
+long long RouteRefresher::GetRefreshCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return refreshCount;
+}
+
+long long RouteRefresher::GetRepairedNodeCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return repairedNodes;
+}
+
+double RouteRefresher::GetLastRefreshTime() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastRefreshTime;
+}
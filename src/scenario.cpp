@@ -0,0 +1,74 @@
+#include "scenario.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+static std::runtime_error ScenarioError(int line, const std::string& message) {
+    return std::runtime_error("scenario line " + std::to_string(line) + ": " + message);
+}
+
+SimulationConfig ParseScenario(std::istream& in, const SimulationConfig& base) {
+    SimulationConfig cfg = base;
+    bool vehiclesGiven = false;
+
+    std::string text;
+    int lineNumber = 0;
+    while (std::getline(in, text)) {
+        lineNumber++;
+        size_t comment = text.find('#');
+        if (comment != std::string::npos) text.erase(comment);
+
+        std::istringstream line(text);
+        std::string key;
+        if (!(line >> key)) continue; // Blank line
+
+        if (key == "seed") {
+            if (!(line >> cfg.seed)) throw ScenarioError(lineNumber, "expected 'seed <number>'");
+        }
+        else if (key == "max_vehicles") {
+            if (!(line >> cfg.maxVehicles) || cfg.maxVehicles < 0) throw ScenarioError(lineNumber, "expected 'max_vehicles <count>'");
+        }
+        else if (key == "tick_rate") {
+            if (!(line >> cfg.tickRate) || cfg.tickRate <= 0.0f) throw ScenarioError(lineNumber, "expected 'tick_rate <ticks per second>'");
+        }
+        else if (key == "threads") {
+            if (!(line >> cfg.threadCount) || cfg.threadCount < 0) throw ScenarioError(lineNumber, "expected 'threads <count>'");
+        }
+        else if (key == "routing") {
+            std::string mode;
+            if (!(line >> mode) || (mode != "on" && mode != "off")) throw ScenarioError(lineNumber, "expected 'routing on|off'");
+            cfg.routing = (mode == "on");
+        }
+        else if (key == "reroute") {
+            if (!(line >> cfg.rerouteInterval) || cfg.rerouteInterval < 0.0f) throw ScenarioError(lineNumber, "expected 'reroute <seconds>'");
+        }
+        else if (key == "vehicle") {
+            VehicleSpawnConfig group;
+            std::string typeName;
+            if (!(line >> typeName >> group.count) || group.count < 0) {
+                throw ScenarioError(lineNumber, "expected 'vehicle <type> <count> <start nodes...>'");
+            }
+            if (!FindVehicleType(typeName, group.type)) {
+                throw ScenarioError(lineNumber, "unknown vehicle type '" + typeName + "'");
+            }
+            int nodeId;
+            while (line >> nodeId) group.startNodes.push_back(nodeId);
+            if (!line.eof()) throw ScenarioError(lineNumber, "start nodes must be node IDs");
+            if (group.startNodes.empty()) throw ScenarioError(lineNumber, "vehicle group without start node");
+
+            if (!vehiclesGiven) cfg.vehicleConfigs.clear();
+            vehiclesGiven = true;
+            cfg.vehicleConfigs.push_back(group);
+        }
+        else {
+            throw ScenarioError(lineNumber, "unknown directive '" + key + "'");
+        }
+    }
+    return cfg;
+}
+
+SimulationConfig LoadScenario(const std::string& path, const SimulationConfig& base) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("cannot open scenario '" + path + "'");
+    return ParseScenario(file, base);
+}
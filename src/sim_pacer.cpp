@@ -0,0 +1,44 @@
+#include "sim_pacer.h"
+#include <chrono>
+
+int SimPacer::GetTickBudget() const {
+    int ticks = (int)(FRAME_BUDGET / tickCost);
+    return ticks < 1 ? 1 : ticks;
+}
+
+bool SimPacer::RunFrame(SimulationCore& sim, float wallDt, float speed) {
+    int maxTicks = GetTickBudget();
+
+    auto start = std::chrono::steady_clock::now();
+    int ticks = sim.Advance(wallDt * speed, maxTicks);
+    double cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (ticks > 0) tickCost += 0.2 * (cost / ticks - tickCost);
+    if (tickCost < 1e-7) tickCost = 1e-7;
+
+    // Keep at most one more budget of owed time (caught up by the skipped frames)
+    sim.DropBacklog(maxTicks);
+    behind = sim.GetBacklog() >= sim.GetTickDt();
+
+    windowWall += wallDt;
+    windowSim += ticks * (double)sim.GetTickDt();
+    if (windowWall >= RATE_WINDOW) {
+        achievedRate = windowSim / windowWall;
+        windowWall = 0.0;
+        windowSim = 0.0;
+    }
+
+    if (behind && skippedFrames < MAX_SKIPPED_FRAMES) {
+        skippedFrames++;
+        return false;
+    }
+    skippedFrames = 0;
+    return true;
+}
+
+void SimPacer::Reset() {
+    behind = false;
+    skippedFrames = 0;
+    windowWall = 0.0;
+    windowSim = 0.0;
+    achievedRate = 0.0;
+}
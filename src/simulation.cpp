@@ -3,76 +3,37 @@
 #include "config.h" //.-.
 #include <cmath> // Needed for fabs
 
-Simulation::Simulation() : trafficMgr(20.0f, 50.0f) {} 
+Simulation::Simulation() {}
 
 void Simulation::Init() {
-    InitializeRoadNetwork(roadGraph);
-
-    // 1. SOUTH LIGHT (Node 16)
-    // Controls traffic entering the roundabout from the South
-    trafficMgr.AddController(16, { 16, 17 }); 
-    trafficMgr.ConfigureTrafficLight(
-        16,                         // ID
-        { 10.5f, 0.0f, 34.0f },     // Position (from Chaimae's basicmap.cpp)
-        0.0f,                       // Rotation (Face Z+)
-        20.0f,                       // Start Delay 20s= red35s -> green50s -> yellow53s
-        15.0f, 3.0f, 15.0f          // Timings: Green, Yellow, Red
-    );
-
-    // 2. NORTH LIGHT (Node 12)
-    // Controls traffic entering from the North
-    trafficMgr.AddController(12, { 12, 13 });
-    trafficMgr.ConfigureTrafficLight(
-        12,                         // ID
-        { -10.5f, 0.0f, -34.0f },   // Position
-        180.0f,                     // Rotation (Face Z-)
-        25.0f,                       // Start Delay 25s= red40s -> green55s -> yellow58s
-        15.0f, 3.0f, 15.0f          // Timings: Green, Yellow, Red
-    );
-
-    // 3. EAST LIGHT (Node 8)
-    // Controls traffic entering from the East
-    trafficMgr.AddController(8, { 8, 9 });
-    trafficMgr.ConfigureTrafficLight(
-        8,                          // ID
-        { 34.0f, 0.0f, -10.5f },    // Position
-        90.0f,                      // Rotation (Face X+)
-        5.0f,                       // Start Delay 5s= red20s -> green35s -> yellow38s
-        15.0f, 3.0f, 15.0f          // Timings: Green, Yellow, Red
-    );
-
-    // 4. WEST LIGHT (Node 2)
-    // Controls traffic entering from the West
-    trafficMgr.AddController(2, { 2, 3 });
-    trafficMgr.ConfigureTrafficLight(
-        2,                          // ID
-        { -34.0f, 0.0f, 10.5f },    // Position
-        270.0f,                     // Rotation (Face X-)
-        0.0f,                       // Start Delay 0= red15s -> green30s -> yellow33s
-        15.0f, 3.0f, 15.0f          // Timings: Green, Yellow, Red
-    );
+    core.Init();
+
+    // The static map is built once into a few merged meshes (needs the window: called after it opens)
+    MeshBuilder builder;
+    BuildBasicMap(builder);
+    staticMap.Load(builder, MAP_TILE_SIZE);
+    TraceLog(LOG_DEBUG, "SIMULATION: Static map baked: %i triangles in %i meshes", staticMap.GetTriangleCount(), staticMap.GetMeshCount());
+    buildings.Load(GetMapBuildings());
+    TraceLog(LOG_DEBUG, "SIMULATION: Buildings: %i placed from %i prototypes", buildings.GetInstanceCount(), buildings.GetPrototypeCount());
+    vehicleRenderer.Load(Vehicle::modelManager);   // Models are loaded by App before Init
+    core.SetRouteSync(false); // A frame never waits for the router thread
 }
 
 void Simulation::ApplyConfiguration() {
-    vehicles.clear();
-    roadGraph.Clear();
-    InitializeRoadNetwork(roadGraph);
-    spawner.LoadFromConfig();
+    core.ApplyConfiguration();
 }
 
 void Simulation::Clear() {
-    vehicles.clear();
-    spawner.Clear();
+    core.Clear();
+    pacer.Reset();
+    renderFrame = true;
 }
 
 int Simulation::GetVehicleCount() const {
-    return (int)vehicles.size();
+    return core.GetVehicleCount();
 }
 
-void Simulation::Update(float dt, Camera3D camera) {
-    // 1. Spawner
-    spawner.Update(roadGraph, vehicles);
-
+void Simulation::Update(float wallDt, float speed, Camera3D camera) {
     // =========================================================
     //  INTERACTION
     // =========================================================
@@ -83,10 +44,17 @@ void Simulation::Update(float dt, Camera3D camera) {
     
     Ray ray = GetMouseRay(scaledMouse, camera);
     
-    Vehicle* hoveredVehicle = nullptr;
+    VehicleKinematics& kin = core.GetVehicles().GetKinematics();
+    float alpha = core.GetInterpolationAlpha();
+    int hoveredVehicle = -1;
     float minHitDist = 9999.0f; // Track closest hit
 
-    for (auto& v : vehicles) {
+    for (size_t i = 0; i < kin.Size(); i++) {
+        // Pick what is on screen (interpolated pose)
+        Vector3 position = kin.InterpolatedPosition(i, alpha);
+        Vector3 forward = kin.InterpolatedForward(i, alpha);
+        float length = kin.length[i];
+
         // --- ADAPTIVE HITBOX MATH ---
         // We calculate how much space the car takes on X and Z axes based on its rotation.
         // Width is approx 2.5m for all cars. Length varies.
@@ -96,13 +64,13 @@ void Simulation::Update(float dt, Camera3D camera) {
         // If facing X: SizeX = Length, SizeZ = Width
         // If facing Z: SizeX = Width,  SizeZ = Length
         // If 45 deg:   SizeX = Mix,    SizeZ = Mix
-        float halfSizeX = (fabs(v->forward.x) * v->length + fabs(v->forward.z) * width) / 2.0f;
-        float halfSizeZ = (fabs(v->forward.z) * v->length + fabs(v->forward.x) * width) / 2.0f;
+        float halfSizeX = (fabs(forward.x) * length + fabs(forward.z) * width) / 2.0f;
+        float halfSizeZ = (fabs(forward.z) * length + fabs(forward.x) * width) / 2.0f;
 
         // Construct the rotating box
         BoundingBox box = {
-            (Vector3){ v->position.x - halfSizeX, v->position.y, v->position.z - halfSizeZ },
-            (Vector3){ v->position.x + halfSizeX, v->position.y + 2.5f, v->position.z + halfSizeZ }
+            (Vector3){ position.x - halfSizeX, position.y, position.z - halfSizeZ },
+            (Vector3){ position.x + halfSizeX, position.y + 2.5f, position.z + halfSizeZ }
         };
 
         // Check Raycast
@@ -112,46 +80,49 @@ void Simulation::Update(float dt, Camera3D camera) {
             // Only pick this car if it is closer than previous hits
             if (collision.distance < minHitDist) {
                 minHitDist = collision.distance;
-                hoveredVehicle = v.get();
+                hoveredVehicle = (int)i;
             }
         }
     }
     
     // --- APPLY INTERACTION TO THE WINNER ---
-    if (hoveredVehicle != nullptr) {
+    if (hoveredVehicle >= 0) {
         SetMouseCursor(MOUSE_CURSOR_POINTING_HAND);
         
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            hoveredVehicle->forceMoveTimer = 2.5f;
+            kin.forceMoveUntil[hoveredVehicle] = core.GetClock().Now() + 2.5;
         }
     }
 
     // =========================================================
 
-    // 2. Traffic Logic
-    trafficMgr.UpdateLights(dt, roadGraph);  // Update lights before vehicles
-    trafficMgr.UpdateVehicles(vehicles, roadGraph);
-    
-    // 3. Physics
-    for (auto &v : vehicles) {
-        v->update(dt, roadGraph, vehicles); 
-    }
+    // =========================================================
+
+    // 2. Traffic, physics, spawning (headless core, fixed ticks: speed means more ticks, never longer ones)
+    renderFrame = pacer.RunFrame(core, wallDt, speed);
 }
 
-void Simulation::Draw3D(bool showDebugNodes) {
-    // 1. Draw the Roads
-    DrawBasicMap();
+void Simulation::Draw3D(bool showDebugNodes, Camera3D camera) {
+    // 0. One culling volume for the whole frame (the game renders to a SCREEN_WIDTH x SCREEN_HEIGHT target)
+    view = Frustum::FromCamera(camera, (float)SimulationConfig::SCREEN_WIDTH / SimulationConfig::SCREEN_HEIGHT);
+
+    // 1. Draw the Roads (baked meshes, tiled) and the buildings
+    staticMap.Draw(view);
+    buildings.Draw(view);
 
     // 2. Draw the Traffic Lights
-    trafficMgr.Draw(); 
+    core.GetTrafficManager().Draw(view);
 
     // 3. Draw Debug Nodes
-    if (showDebugNodes) roadGraph.DrawNodes();
+    if (showDebugNodes) core.GetRoadGraph().DrawNodes(view);
 
     // 4. Draw Vehicles
-    for (auto &v : vehicles) v->draw();
+    const VehiclePool& vehicles = core.GetVehicles();
+    // Poses are interpolated between the last two ticks (smooth at any tick rate / refresh rate)
+    float alpha = core.GetInterpolationAlpha();
+    Vehicle::DrawAll(vehicles, alpha, view, &vehicleRenderer);
 }
 
 void Simulation::DrawOverlay(bool showDebugNodes, Camera3D camera) {
-    if (showDebugNodes) roadGraph.DrawIdNodes(camera);
+    if (showDebugNodes) core.GetRoadGraph().DrawIdNodes(camera, view);
 }
\ No newline at end of file
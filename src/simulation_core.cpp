@@ -0,0 +1,292 @@
+#include "simulation_core.h"
+#include "road_network.h"
+#include "config.h"
+#include <algorithm>
+#include <chrono>
+
+SimulationCore::SimulationCore() : trafficMgr(20.0f, 50.0f) {
+    BuildStepGraph();
+}
+
+void SimulationCore::Init() {
+    router.Stop(); // Its worker reads roadGraph (see ApplyConfiguration)
+    InitializeRoadNetwork(roadGraph);
+
+    // 1. SOUTH LIGHT (Node 16)
+    // Controls traffic entering the roundabout from the South
+    trafficMgr.AddController(16, { 16, 17 }); 
+    trafficMgr.ConfigureTrafficLight(
+        16,                         // ID
+        { 10.5f, 0.0f, 34.0f },     // Position (from Chaimae's basicmap.cpp)
+        0.0f,                       // Rotation (Face Z+)
+        20.0f,                       // Start Delay 20s= red35s -> green50s -> yellow53s
+        15.0f, 3.0f, 15.0f          // Timings: Green, Yellow, Red
+    );
+
+    // 2. NORTH LIGHT (Node 12)
+    // Controls traffic entering from the North
+    trafficMgr.AddController(12, { 12, 13 });
+    trafficMgr.ConfigureTrafficLight(
+        12,                         // ID
+        { -10.5f, 0.0f, -34.0f },   // Position
+        180.0f,                     // Rotation (Face Z-)
+        25.0f,                       // Start Delay 25s= red40s -> green55s -> yellow58s
+        15.0f, 3.0f, 15.0f          // Timings: Green, Yellow, Red
+    );
+
+    // 3. EAST LIGHT (Node 8)
+    // Controls traffic entering from the East
+    trafficMgr.AddController(8, { 8, 9 });
+    trafficMgr.ConfigureTrafficLight(
+        8,                          // ID
+        { 34.0f, 0.0f, -10.5f },    // Position
+        90.0f,                      // Rotation (Face X+)
+        5.0f,                       // Start Delay 5s= red20s -> green35s -> yellow38s
+        15.0f, 3.0f, 15.0f          // Timings: Green, Yellow, Red
+    );
+
+    // 4. WEST LIGHT (Node 2)
+    // Controls traffic entering from the West
+    trafficMgr.AddController(2, { 2, 3 });
+    trafficMgr.ConfigureTrafficLight(
+        2,                          // ID
+        { -34.0f, 0.0f, 10.5f },    // Position
+        270.0f,                     // Rotation (Face X-)
+        0.0f,                       // Start Delay 0= red15s -> green30s -> yellow33s
+        15.0f, 3.0f, 15.0f          // Timings: Green, Yellow, Red
+    );
+
+    trafficMgr.BindSignals(roadGraph);
+    trafficMgr.StartLights(events, roadGraph);
+    WatchEntryPoints();
+}
+
+void SimulationCore::ApplyConfiguration() {
+    // First of all: without route sync the router thread may still be repairing its trees,
+    // reading roadGraph, which is rebuilt below (PlanRoutes starts it again on the new graph)
+    router.Stop();
+    vehicles.Clear();
+    roadGraph.Clear();
+    InitializeRoadNetwork(roadGraph);
+    trafficMgr.BindSignals(roadGraph);
+    spawner.LoadFromConfig();
+    tickDt = 1.0f / (globalConfig.tickRate > 0.0f ? globalConfig.tickRate : 60.0f);
+    accumulator = 0.0f;
+    jobs.SetThreadCount(globalConfig.threadCount);
+    vehicles.Reserve(spawner.GetQueuedCount()); // No allocation while the demand is spawned
+    WatchEntryPoints();
+    PlanRoutes();
+}
+
+void SimulationCore::PlanRoutes() {
+    // Every trip starts on a START node (spawn point or teleport landing) and ends on a
+    // TELEPORT node (map exit): one shortest-path tree per exit, planned here before the first
+    // tick. The router thread then keeps them up to date with the travel times the vehicles
+    // observe (see RefreshRoutes).
+    auto start = std::chrono::steady_clock::now();
+    router.Stop();
+    travelTimes.Reset(roadGraph, CONFIG::FREE_FLOW_SPEED);
+    ticksSinceReroute = 0;
+    routePlanningTime = 0.0;
+    if (!globalConfig.routing) {
+        std::shared_ptr<RouteTable> none = std::make_shared<RouteTable>();
+        none->Clear(roadGraph.GetNodeCount());
+        routes = none;
+        trafficMgr.SetRoutes(routes.get());
+        return;
+    }
+
+    std::vector<int> exits;
+    for (int n = 0; n < roadGraph.GetNodeCount(); n++) {
+        if (roadGraph.TypeOf(n) == TELEPORT) exits.push_back(n);
+    }
+    router.Start(roadGraph, exits, travelTimes.GetFreeFlowTimes(), &jobs);
+    routes = router.GetRoutes();
+    trafficMgr.SetRoutes(routes.get());
+    routePlanningTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void SimulationCore::RefreshRoutes() {
+    // Between two ticks: the vehicles only switch tables here. Every rerouteInterval the
+    // latest routes are adopted and the current travel times are handed to the router.
+    if (!router.IsRunning() || globalConfig.rerouteInterval <= 0.0f) return;
+    int interval = std::max(1, (int)(globalConfig.rerouteInterval / tickDt + 0.5f));
+    if (++ticksSinceReroute < interval) return;
+    ticksSinceReroute = 0;
+
+    if (waitForRoutes) router.WaitIdle();
+    std::shared_ptr<const RouteTable> latest = router.GetRoutes();
+    if (latest != routes) {
+        routes = latest;
+        trafficMgr.SetRoutes(routes.get());
+    }
+    travelTimes.Snapshot(vehicles.GetKinematics(), roadGraph, snapshotCosts);
+    router.Submit(snapshotCosts);
+}
+
+void SimulationCore::WatchEntryPoints() {
+    // START nodes and teleport landings are always watched, add the configured spawn nodes
+    std::vector<int> spawnNodes;
+    for (const auto& cfg : globalConfig.vehicleConfigs) {
+        spawnNodes.insert(spawnNodes.end(), cfg.startNodes.begin(), cfg.startNodes.end());
+    }
+    occupancy.Watch(roadGraph, spawnNodes);
+}
+
+void SimulationCore::Clear() {
+    vehicles.Clear();
+    spawner.Clear();
+    accumulator = 0.0f;
+}
+
+int SimulationCore::Advance(float dt, int maxTicks) {
+    accumulator += dt;
+    int ticks = 0;
+    while (accumulator >= tickDt && ticks < maxTicks) {
+        Step(tickDt);
+        accumulator -= tickDt;
+        ticks++;
+    }
+    return ticks;
+}
+
+void SimulationCore::DropBacklog(int maxTicks) {
+    float limit = maxTicks * tickDt;
+    if (accumulator > limit) accumulator = limit;
+}
+
+void SimulationCore::Step(float dt) {
+    RefreshRoutes();
+    stepDt = dt;
+    jobs.Run();
+}
+
+// One tick as a task graph (run by Step). Dependencies:
+//   clock         -> prev pose, occupancy
+//   prev pose     -> spawn          occupancy -> spawn
+//   spawn         -> traffic prep -> grid, lanes -> speeds -> commit speeds
+//   commit speeds -> drive -> teleports -> metrics, type behaviour, travel times -> reduce metrics
+// 'prev pose', 'speeds', 'drive', 'metrics' and 'type behaviour' are split into chunks of VEHICLE_BATCH vehicles.
+// Every chunk writes only its own vehicles (and its own metrics slot), so the result does not
+// depend on the thread count.
+void SimulationCore::BuildStepGraph() {
+    const size_t batch = SimulationConfig::VEHICLE_BATCH;
+    auto vehicleCount = [this]() { return vehicles.Count(); };
+
+    // 0. Sim clock (fires due events: light phases, spawn retries)
+    TaskId clock = jobs.AddTask("clock", [this]() { events.Advance(stepDt); });
+
+    // Render interpolates from here
+    TaskId prevPose = jobs.AddParallelTask("prev pose", vehicleCount, batch, [this](size_t begin, size_t end) {
+        vehicles.GetKinematics().SavePreviousPose(begin, end);
+    });
+
+    // 1. Spawner (entry point occupancy counted once per tick)
+    TaskId occupancyCount = jobs.AddTask("occupancy", [this]() { occupancy.Update(vehicles); });
+    TaskId spawn = jobs.AddTask("spawn", [this]() {
+        size_t before[VEHICLE_TYPE_COUNT];
+        for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) before[t] = vehicles.CountOf((VehicleType)t);
+        size_t total = vehicles.Count();
+        spawner.Update(roadGraph, vehicles, occupancy, events, routes.get());
+        stats.spawned += (int)(vehicles.Count() - total);
+        for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+            stats.byType[t].spawned += (int)(vehicles.CountOf((VehicleType)t) - before[t]);
+        }
+    });
+
+    // 2. Traffic Logic
+    // (Lights change on their own scheduled events, see TrafficManager::StartLights)
+    // Speeds are computed from the previous tick only, then committed at once
+    TaskId trafficPrep = jobs.AddTask("traffic prep", [this]() { trafficMgr.BeginUpdate(vehicles.GetKinematics(), roadGraph); });
+    TaskId grid = jobs.AddTask("grid", [this]() { trafficMgr.BuildGrid(vehicles.GetKinematics()); });
+    TaskId lanes = jobs.AddTask("lanes", [this]() { trafficMgr.BuildLanes(vehicles.GetKinematics(), roadGraph); });
+    TaskId speeds = jobs.AddParallelTask("speeds", vehicleCount, batch, [this](size_t begin, size_t end) {
+        trafficMgr.ComputeSpeeds(begin, end, vehicles.GetKinematics(), roadGraph, stepDt);
+    });
+    TaskId commit = jobs.AddTask("commit speeds", [this]() {
+        trafficMgr.CommitSpeeds(vehicles.GetKinematics());
+        atTeleport.assign(vehicles.Count(), 0);
+        driveScratch.Resize(vehicles.Count());
+    });
+
+    // 3. Physics (straight over the kinematics arrays)
+    // Each vehicle only writes its own row; teleport landings share the occupancy index,
+    // so they are resolved after the parallel pass, in vehicle order
+    TaskId drive = jobs.AddParallelTask("drive", vehicleCount, batch, [this](size_t begin, size_t end) {
+        Vehicle::DriveRange(vehicles.GetKinematics(), begin, end, stepDt, roadGraph, driveScratch, atTeleport.data(), routes.get());
+    });
+    TaskId teleports = jobs.AddTask("teleports", [this]() {
+        VehicleKinematics& kin = vehicles.GetKinematics();
+        for (size_t i = 0; i < kin.Size(); i++) {
+            if (atTeleport[i]) Vehicle::Teleport(kin, i, roadGraph, occupancy, routes.get());
+        }
+        tickMetrics.assign((kin.Size() + SimulationConfig::VEHICLE_BATCH - 1) / SimulationConfig::VEHICLE_BATCH, ChunkMetrics());
+    });
+    // Edges finished this tick feed the travel time estimates (read by the next reroute)
+    TaskId travel = jobs.AddTask("travel times", [this]() { travelTimes.Collect(vehicles.GetKinematics()); });
+    // Per-type behaviour (motorcycle tilt): only the cold objects of the animated groups, next to the metrics
+    auto animatedCount = [this]() {
+        size_t end;
+        Vehicle::AnimatedRows(vehicles, animatedFirst, end);
+        return end - animatedFirst;
+    };
+    TaskId behaviour = jobs.AddParallelTask("type behaviour", animatedCount, batch, [this](size_t begin, size_t end) {
+        Vehicle::AnimateRange(vehicles, animatedFirst + begin, animatedFirst + end, stepDt);
+    });
+
+    // 4. Statistics (one partial sum per chunk, added up in chunk order)
+    TaskId metrics = jobs.AddParallelTask("metrics", vehicleCount, batch, [this](size_t begin, size_t end) {
+        const VehicleKinematics& kin = vehicles.GetKinematics();
+        ChunkMetrics& m = tickMetrics[begin / SimulationConfig::VEHICLE_BATCH];
+        // Rows are grouped by type: per-type sums over the part of each group in the chunk
+        for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+            size_t first = std::max(begin, vehicles.GroupBegin((VehicleType)t));
+            size_t last = std::min(end, vehicles.GroupEnd((VehicleType)t));
+            for (size_t i = first; i < last; i++) {
+                m.speedSum += kin.speed[i];
+                m.typeSpeedSum[t] += kin.speed[i];
+                if (kin.speed[i] < SimulationStats::STOPPED_SPEED) m.stoppedUpdates++;
+            }
+            if (last > first) m.typeUpdates[t] += (long long)(last - first);
+        }
+    });
+    TaskId reduce = jobs.AddTask("reduce metrics", [this]() {
+        size_t count = vehicles.Count();
+        stats.ticks++;
+        stats.simTime += stepDt;
+        stats.vehicleUpdates += (long long)count;
+        if ((int)count > stats.peakVehicles) stats.peakVehicles = (int)count;
+        for (const ChunkMetrics& m : tickMetrics) {
+            stats.speedSum += m.speedSum;
+            stats.stoppedUpdates += m.stoppedUpdates;
+            for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+                stats.byType[t].speedSum += m.typeSpeedSum[t];
+                stats.byType[t].updates += m.typeUpdates[t];
+            }
+        }
+
+        // 5. Reclaim vehicles that left the network (their slots are reused by the spawner)
+        int completed[VEHICLE_TYPE_COUNT] = {};
+        stats.completed += vehicles.RemoveFinished(completed);
+        for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) stats.byType[t].completed += completed[t];
+    });
+
+    jobs.AddDependency(clock, prevPose);
+    jobs.AddDependency(clock, occupancyCount);
+    jobs.AddDependency(prevPose, spawn);        // Spawning grows the arrays under the chunks
+    jobs.AddDependency(occupancyCount, spawn);
+    jobs.AddDependency(spawn, trafficPrep);
+    jobs.AddDependency(trafficPrep, grid);
+    jobs.AddDependency(trafficPrep, lanes);
+    jobs.AddDependency(grid, speeds);
+    jobs.AddDependency(lanes, speeds);
+    jobs.AddDependency(speeds, commit);
+    jobs.AddDependency(commit, drive);
+    jobs.AddDependency(drive, teleports);
+    jobs.AddDependency(teleports, metrics);
+    jobs.AddDependency(metrics, reduce);
+    jobs.AddDependency(teleports, behaviour);
+    jobs.AddDependency(behaviour, reduce);      // RemoveFinished moves the rows
+    jobs.AddDependency(teleports, travel);
+    jobs.AddDependency(travel, reduce);
+}
@@ -0,0 +1,69 @@
+#include "spatial_grid.h"
+#include <algorithm>
+
+// Upper bound on cells per point, so a few far-away vehicles
+// cannot blow up the grid (cells get larger instead).
+static const int MAX_CELLS_PER_POINT = 4;
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : baseCellSize(cellSize), cellSize(cellSize), minX(0.0f), minZ(0.0f), cols(1), rows(1) {}
+
+int SpatialGrid::CellX(float x) const {
+    int c = (int)floorf((x - minX) / cellSize);
+    if (c < 0) return 0;
+    if (c >= cols) return cols - 1;
+    return c;
+}
+
+int SpatialGrid::CellZ(float z) const {
+    int c = (int)floorf((z - minZ) / cellSize);
+    if (c < 0) return 0;
+    if (c >= rows) return rows - 1;
+    return c;
+}
+
+void SpatialGrid::Build(const std::vector<Vector3>& points) {
+    entries.clear();
+    pointCell.clear();
+    cols = rows = 1;
+    cellStart.assign(2, 0);
+    if (points.empty()) return;
+
+    // --- 1. BOUNDS ---
+    float maxX = points[0].x, maxZ = points[0].z;
+    minX = points[0].x;
+    minZ = points[0].z;
+    for (const auto& p : points) {
+        minX = std::min(minX, p.x); maxX = std::max(maxX, p.x);
+        minZ = std::min(minZ, p.z); maxZ = std::max(maxZ, p.z);
+    }
+
+    // --- 2. DIMENSIONS (Grow the cells if the extent is huge) ---
+    float size = baseCellSize;
+    long long maxCells = (long long)points.size() * MAX_CELLS_PER_POINT + 16;
+    for (;;) {
+        cols = (int)((maxX - minX) / size) + 1;
+        rows = (int)((maxZ - minZ) / size) + 1;
+        if ((long long)cols * rows <= maxCells) break;
+        size *= 2.0f;
+    }
+    cellSize = size;
+
+    // --- 3. COUNTING SORT ---
+    int cellCount = cols * rows;
+    cellStart.assign(cellCount + 1, 0);
+    pointCell.resize(points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+        int cell = CellZ(points[i].z) * cols + CellX(points[i].x);
+        pointCell[i] = cell;
+        cellStart[cell + 1]++;
+    }
+    for (int c = 0; c < cellCount; c++) cellStart[c + 1] += cellStart[c];
+
+    entries.resize(points.size());
+    cursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < points.size(); i++) {
+        entries[cursor[pointCell[i]]++] = (int)i;
+    }
+}
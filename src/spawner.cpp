@@ -1,78 +1,80 @@
 #include "spawner.h"
 #include "raymath.h" // For Vector3 operations
 
+// Delay before a blocked start node is checked again (seconds of sim time)
+static const double SPAWN_RETRY_DELAY = 0.25;
+
 VehicleSpawner::VehicleSpawner() {}
 
+StartQueue& VehicleSpawner::GetQueue(int startNodeId) {
+    auto found = queueOfNode.find(startNodeId);
+    if (found != queueOfNode.end()) return startQueues[found->second];
+
+    queueOfNode[startNodeId] = (int)startQueues.size();
+    startQueues.push_back({ startNodeId, std::deque<VehicleType>() });
+    return startQueues.back();
+}
+
 void VehicleSpawner::LoadFromConfig() {
-    spawnQueue.clear();
+    Clear();
+    rng.Seed(globalConfig.seed);
     for (const auto& cfg : globalConfig.vehicleConfigs) {
+        if (cfg.startNodes.empty()) continue;
         for(int i = 0; i < cfg.count; i++) {
-            if (cfg.startNodes.empty()) continue;
-            int nodeId = cfg.startNodes[GetRandomValue(0, cfg.startNodes.size() - 1)];
-            spawnQueue.push_back({cfg.type, nodeId});
+            int nodeId = cfg.startNodes[rng.Range(0, (int)cfg.startNodes.size() - 1)];
+            GetQueue(nodeId).types.push_back(cfg.type);
+            queuedCount++;
         }
     }
 }
 
 void VehicleSpawner::Clear() {
-    spawnQueue.clear();
+    startQueues.clear();
+    queueOfNode.clear();
+    queuedCount = 0;
 }
 
-std::unique_ptr<Vehicle> VehicleSpawner::CreateVehicle(const std::string& type, Vector3 pos, int target) {
-    if (type == "Car") return std::make_unique<Car>(pos, target);
-    if (type == "Bus") return std::make_unique<Bus>(pos, target);
-    if (type == "Truck") return std::make_unique<Truck>(pos, target);
-    if (type == "Taxi") return std::make_unique<Taxi>(pos, target);
-    if (type == "Police") return std::make_unique<PoliceCar>(pos, target);
-    if (type == "Motorcycle") return std::make_unique<Motorcycle>(pos, target);
-    return nullptr;
-}
+void VehicleSpawner::Update(RoadGraph& graph, VehiclePool& vehicles, OccupancyIndex& occupancy, EventScheduler& clock,
+                            const RouteTable* routes) {
+    if (queuedCount == 0) return;
+    double now = clock.Now();
 
-void VehicleSpawner::Update(RoadGraph& graph, std::vector<std::unique_ptr<Vehicle>>& vehicles) {
-    for (auto it = spawnQueue.begin(); it != spawnQueue.end(); ) {
-        Node &n = graph.GetNode(it->startNodeId);
+    for (auto& queue : startQueues) {
+        if (queue.types.empty() || now < queue.retryAt) continue;
 
-        // --- 1. SMART SAFETY CHECK ---
-        // We check physical space.
-        // We assume the node is blocked until proven otherwise.
-        bool isBlocked = false;
+        int start = graph.IndexOf(queue.startNodeId);
+        Vector3 startPos = graph.PositionOf(start);
 
-        for (const auto& v : vehicles) {
-            // Distance Check:
-            // 8.0f ensures a natural "following distance" gap.
-            if (Vector3Distance(v->position, n.pos) < 8.0f) {
-                isBlocked = true;
-                break;
-            }
+        // --- 1. SMART SAFETY CHECK ---
+        // We check physical space: nobody within NODE_CLEAR_RADIUS of the start node
+        // (a natural "following distance" gap), answered by the occupancy index.
+        if (!occupancy.IsClear(start)) {
+            // Blocked: the whole queue waits behind its head (this queue only)
+            queue.retryAt = now + SPAWN_RETRY_DELAY;
+            continue;
         }
 
-        // --- 2. SPAWN LOGIC ---
-        // Only spawn if the spawn point is physically clear (!isBlocked)
-        if (!isBlocked) {
-
-            if (!n.nextNodes.empty()) {
-                Vector3 pos = n.pos;
-                int target = n.nextNodes[0];
+        // --- 2. SPAWN LOGIC (Head of the queue only) ---
+        NodeRange next = graph.Successors(start);
+        if (!next.empty()) {
+            // 1. Initial state, facing the first edge (of its route when it has one)
+            VehicleState state;
+            state.routeSeed = rng.Next();
+            state.routeId = routes ? routes->PickFrom(start, state.routeSeed) : -1;
+            int first = state.routeId >= 0 ? routes->NextNode(state.routeId, start) : next[0];
+            state.position = startPos;
+            state.forward = Vector3Normalize(Vector3Subtract(graph.PositionOf(first), startPos));
+            state.targetNodeId = graph.IdOf(first);
+            state.currentNodeId = queue.startNodeId;
 
-                // 1. Create the specific vehicle
-                auto newVehicle = CreateVehicle(it->type, pos, target);
-                
-                // 2. Fix Orientation
-                if (newVehicle) {
-                    Vector3 targetPos = graph.GetNode(target).pos;
-                    Vector3 dir = Vector3Subtract(targetPos, pos);
-                    newVehicle->forward = Vector3Normalize(dir);
-                    
-                    // Add to the main simulation list
-                    vehicles.push_back(std::move(newVehicle));
-                }
+            // 2. Create the specific vehicle (directly in the pool, indexed by type)
+            if (vehicles.Get(vehicles.Create(queue.types.front(), state))) {
+                occupancy.MarkArrival(start);
             }
-
-            // Success: Remove from queue
-            it = spawnQueue.erase(it);
-        } else {
-            // Blocked: Try next one later
-            ++it;
         }
+
+        // Success: Remove from queue
+        queue.types.pop_front();
+        queuedCount--;
     }
-}
\ No newline at end of file
+}
@@ -1,34 +1,31 @@
 #include "traffic_manager.h"
 #include "vehicle.h"
+#include "vehicle_pool.h"
+#include "job_system.h"
+#include "kinematics_kernel.h"
+#include "route_planner.h"
 #include <cmath>
 #include <algorithm>
 #include "raymath.h" 
 
+// Safety cap for the downstream lane walk (arc edges are only a few meters long)
+static const int MAX_LANE_WALK_EDGES = 64;
+// Speed of a clicked vehicle ("angry mode": obstacles ignored)
+static const float FORCED_SPEED = 18.0f;
+
 // =============================================================================
 //  HELPER FUNCTIONS
 // =============================================================================
 
-float TrafficManager::GetDistance(const Vector3& a, const Vector3& b) {
+float TrafficManager::GetDistance(const Vector3& a, const Vector3& b) const {
     return Vector3Distance(a, b);
 }
 
-bool TrafficManager::AreSameDirection(const Vector3& dir1, const Vector3& dir2) {
+bool TrafficManager::AreSameDirection(const Vector3& dir1, const Vector3& dir2) const {
     float dotProduct = dir1.x * dir2.x + dir1.z * dir2.z;
     return dotProduct > 0.7f;
 }
 
-bool TrafficManager::IsInMyLane(Vehicle* me, Vehicle* other) {
-    Vector3 toOther = Vector3Subtract(other->position, me->position);
-
-    float forwardDist = Vector3DotProduct(toOther, me->forward);
-    if (forwardDist < 0) return false; // Behind us
-
-    Vector3 right = { -me->forward.z, 0, me->forward.x };
-    float sideDist = Vector3DotProduct(toOther, right);
-
-    return fabs(sideDist) < 1.8f; // Within lane width
-}
-
 float TrafficManager::Lerp(float start, float end, float amount) {
     return start + amount * (end - start);
 }
@@ -38,7 +35,7 @@ float TrafficManager::Lerp(float start, float end, float amount) {
 // =============================================================================
 
 TrafficManager::TrafficManager(float slowDist, float detection)
-    : startSlowingDist(slowDist), minSafeDist(4.0f), detectionRange(detection) {}
+    : startSlowingDist(slowDist), minSafeDist(4.0f), detectionRange(detection), vehicleGrid(detection * 0.5f) {}
 
 void TrafficManager::AddController(int id, std::vector<int> nodeIds) {
     TrafficController ctrl;
@@ -47,7 +44,7 @@ void TrafficManager::AddController(int id, std::vector<int> nodeIds) {
     ctrl.id = id;
     ctrl.nodeIds = nodeIds;
     ctrl.currentState = LIGHT_GREEN; 
-    ctrl.timer = 0.0f;
+    ctrl.phaseEvent = 0;
     
     // Default values (will be overwritten by ConfigureTrafficLight)
     ctrl.durationGreen = 15.0f;
@@ -57,6 +54,20 @@ void TrafficManager::AddController(int id, std::vector<int> nodeIds) {
     ctrl.position = {0,0,0};
 
     controllers.push_back(ctrl);
+    signalsDirty = true;
+}
+
+void TrafficManager::BindSignals(const RoadGraph& map) {
+    signals.assign(map.GetNodeCount(), SignalSlot());
+
+    for (size_t c = 0; c < controllers.size(); c++) {
+        for (int nodeId : controllers[c].nodeIds) {
+            int index = map.IndexOf(nodeId);
+            signals[index].controller = (int)c;
+            signals[index].stopLine = map.PositionOf(index);
+        }
+    }
+    signalsDirty = false;
 }
 
 void TrafficManager::ConfigureTrafficLight(int controllerId, Vector3 position, float rotation, float startRedTime, float greenTime, float yellowTime, float redTime) {
@@ -82,247 +93,362 @@ void TrafficManager::ConfigureTrafficLight(int controllerId, Vector3 position, f
 }
 
 // =============================================================================
-//  DRAWING LOGIC
+//  LIGHT PHASES
 // =============================================================================
-void TrafficManager::DrawTrafficLightModel(Vector3 pos, float angleY, LightState state) {
-    rlPushMatrix();
-    
-    // 1. Move to position
-    rlTranslatef(pos.x, pos.y, pos.z);
-    
-    // 2. Rotate to face the road
-    rlRotatef(angleY, 0, 1, 0);
+void TrafficManager::StartLights(EventScheduler& simClock, RoadGraph& map) {
+    clock = &simClock;
+    lightGraph = &map;
+    if (signalsDirty) BindSignals(map);
+
+    for (size_t i = 0; i < controllers.size(); i++) {
+        if (controllers[i].phaseEvent) clock->Cancel(controllers[i].phaseEvent);
+        SchedulePhaseChange(i);
+    }
+}
 
-    // --- DRAWING IN LOCAL COORDINATES ---
-    
-    float poleHeight = 6.0f;
-    float armLength = 6.5f; 
-
-    // A. The Pole
-    // Note: Chaimae offsets the pole slightly (x=1.0) so the light hangs over 0.0
-    DrawCylinder({1.0f, 0.0f, 0.0f}, 0.3f, 0.3f, poleHeight, 16, DARKGRAY);
-
-    // B. The Horizontal Arm
-    Vector3 armStart = {1.0f, poleHeight - 0.5f, 0.0f};
-    Vector3 armEnd   = {1.0f - armLength, poleHeight - 0.5f, 0.0f};
-    DrawCylinderEx(armStart, armEnd, 0.2f, 0.2f, 8, DARKGRAY);
-
-    // C. The Light Box
-    Vector3 boxPos = armEnd;
-    float w=0.6f, h=1.8f, d=0.6f;
-    Vector3 boxCenter = {boxPos.x, boxPos.y - 0.8f, boxPos.z};
-    
-    DrawCube(boxCenter, w, h, d, BLACK);
-    DrawCubeWires(boxCenter, w, h, d, DARKGRAY); 
+float TrafficManager::GetPhaseDuration(const TrafficController& ctrl) const {
+    switch (ctrl.currentState) {
+        case LIGHT_GREEN:  return ctrl.durationGreen; // Uses custom timer
+        case LIGHT_YELLOW: return ctrl.durationYellow;
+        case LIGHT_RED:    return ctrl.durationRed;
+        default:           return 0.0f;
+    }
+}
 
-    // D. The Lights (Red/Yellow/Green)
-    float zFace = boxCenter.z + (d/2) + 0.05f; 
+void TrafficManager::SchedulePhaseChange(size_t index) {
+    TrafficController& ctrl = controllers[index];
+    if (ctrl.currentState == LIGHT_NONE) {
+        ctrl.phaseEvent = 0;
+        return;
+    }
+    ctrl.phaseEvent = clock->Schedule(GetPhaseDuration(ctrl), [this, index]() { AdvancePhase(index); });
+}
 
-    // Colors: Dim if off, Bright if on
-    Color cRed    = (state == LIGHT_RED)    ? RED    : (Color){50, 0, 0, 255};   
-    Color cYellow = (state == LIGHT_YELLOW) ? ORANGE : (Color){50, 40, 0, 255};
-    Color cGreen  = (state == LIGHT_GREEN)  ? GREEN  : (Color){0, 50, 0, 255}; 
+void TrafficManager::AdvancePhase(size_t index) {
+    TrafficController& ctrl = controllers[index];
 
-    DrawSphere({boxCenter.x, boxCenter.y + 0.5f, zFace}, 0.22f, cRed);    // Top
-    DrawSphere({boxCenter.x, boxCenter.y,        zFace}, 0.22f, cYellow); // Middle
-    DrawSphere({boxCenter.x, boxCenter.y - 0.5f, zFace}, 0.22f, cGreen);  // Bottom
-    
-    rlPopMatrix();
-}
+    switch (ctrl.currentState) {
+        case LIGHT_GREEN:
+            ctrl.currentState = LIGHT_YELLOW;
+            break;
+        case LIGHT_YELLOW:
+            ctrl.currentState = LIGHT_RED;
+            ctrl.durationRed = 15.0f; 
+            break;
+        case LIGHT_RED:
+            ctrl.currentState = LIGHT_GREEN;
+            ctrl.durationGreen = 15.0f; 
+            break;
+        default: break;
+    }
 
-void TrafficManager::Draw() {
-    for (const auto& ctrl : controllers) {
-        DrawTrafficLightModel(ctrl.position, ctrl.rotation, ctrl.currentState);
+    // Node IDs were checked by BindSignals
+    for (int nodeId : ctrl.nodeIds) {
+        lightGraph->GetNode(nodeId).lightState = ctrl.currentState;
     }
+
+    SchedulePhaseChange(index);
 }
 
 // =============================================================================
-//  UPDATE LIGHTS
+//  LANES
 // =============================================================================
-void TrafficManager::UpdateLights(float dt, RoadGraph& map) {
-    for (auto& ctrl : controllers) {
-        ctrl.timer += dt;
 
-        switch (ctrl.currentState) {
-            case LIGHT_GREEN:
-                if (ctrl.timer >= ctrl.durationGreen) { // Uses custom timer
-                    ctrl.currentState = LIGHT_YELLOW;
-                    ctrl.timer = 0.0f;
-                }
-                break;
-            case LIGHT_YELLOW:
-                if (ctrl.timer >= ctrl.durationYellow) {
-                    ctrl.currentState = LIGHT_RED;
-                    ctrl.timer = 0.0f;
-                    ctrl.durationRed = 15.0f; 
-                }
-                break;
-            case LIGHT_RED:
-                if (ctrl.timer >= ctrl.durationRed) {
-                    ctrl.currentState = LIGHT_GREEN;
-                    ctrl.timer = 0.0f;
-                    ctrl.durationGreen = 15.0f; 
-                }
-                break;
-            default: break;
+long long TrafficManager::EdgeKey(int fromId, int toId) {
+    return ((long long)fromId << 32) | (unsigned int)toId;
+}
+
+float TrafficManager::DistanceAlongEdge(const Vector3& pos, const RoadGraph& map, int fromId, int toId) const {
+    Vector3 from = map.PositionOf(map.IndexOf(fromId));
+    Vector3 dir = Vector3Subtract(map.PositionOf(map.IndexOf(toId)), from);
+    float len = Vector3Length(dir);
+    if (len <= 0.0f) return 0.0f;
+    return Vector3DotProduct(Vector3Subtract(pos, from), dir) / len;
+}
+
+void TrafficManager::BuildLanes(const VehicleKinematics& k, const RoadGraph& map) {
+    // Keep the vectors (and their capacity) between ticks, only empty them
+    for (auto& lane : lanes) lane.second.slots.clear();
+    for (auto& into : lanesInto) into.second.clear();
+
+    for (size_t i = 0; i < k.Size(); i++) {
+        int fromId = k.currentNodeId[i];
+        int toId = k.targetNodeId[i];
+        if (k.finished[i] || fromId < 0) continue;
+
+        Lane& lane = lanes[EdgeKey(fromId, toId)];
+        if (lane.slots.empty()) {
+            lane.toId = toId;
+            lane.length = Vector3Distance(map.PositionOf(map.IndexOf(fromId)), map.PositionOf(map.IndexOf(toId)));
+            lanesInto[toId].push_back(&lane);
         }
+        // Targets switch within ARRIVAL_THRESHOLD of a node, so 's' is slightly negative right after a switch
+        float s = DistanceAlongEdge(k.Position(i), map, fromId, toId);
+        lane.slots.push_back({ (int)i, s });
+    }
 
-        for (int nodeId : ctrl.nodeIds) {
-            try {
-                Node& node = map.GetNode(nodeId);
-                node.lightState = ctrl.currentState;
-            } catch (...) {}
+    laneRank.assign(k.Size(), -1);
+    for (auto& entry : lanes) {
+        std::vector<LaneSlot>& slots = entry.second.slots;
+        std::sort(slots.begin(), slots.end(), [](const LaneSlot& a, const LaneSlot& b) { return a.s < b.s; });
+        for (size_t r = 0; r < slots.size(); r++) laneRank[slots[r].vehicle] = (int)r;
+    }
+}
+
+int TrafficManager::FindAheadAtNode(int nodeId, float distToNode, int me, const VehicleKinematics& k, float& gapOut) const {
+    auto into = lanesInto.find(nodeId);
+    if (into == lanesInto.end()) return -1;
+
+    int best = -1;
+    float bestRemaining = -1.0f;
+
+    for (const Lane* lane : into->second) {
+        // First slot whose distance to the node is below ours (slots are sorted by 's')
+        float minS = lane->length - distToNode;
+        auto it = std::upper_bound(lane->slots.begin(), lane->slots.end(), minS,
+                                   [](float value, const LaneSlot& slot) { return value < slot.s; });
+        for (; it != lane->slots.end(); ++it) {
+            int other = it->vehicle;
+            if (other == me) continue;
+
+            float remaining = lane->length - it->s;
+            if (remaining > bestRemaining) {
+                bestRemaining = remaining;
+                best = other;
+            }
+            break;
         }
     }
+
+    if (best >= 0) gapOut = (distToNode - bestRemaining) - (k.length[me] * 0.5f + k.length[best] * 0.5f);
+    return best;
 }
 
-// =============================================================================
-//  UPDATE VEHICLES
-// =============================================================================
+int TrafficManager::FindLeader(size_t index, const VehicleKinematics& k, const RoadGraph& map, float range, float& gapOut) const {
+    int me = (int)index;
+    if (laneRank[index] < 0) return -1;
+
+    const Lane& myLane = lanes.find(EdgeKey(k.currentNodeId[me], k.targetNodeId[me]))->second; // Ranked, so it exists
+    const LaneSlot& mySlot = myLane.slots[laneRank[index]];
+    float myRemaining = myLane.length - mySlot.s;
+
+    // A. Someone ahead on the same edge
+    if (laneRank[index] + 1 < (int)myLane.slots.size()) {
+        const LaneSlot& ahead = myLane.slots[laneRank[index] + 1];
+        int other = ahead.vehicle;
+        gapOut = (ahead.s - mySlot.s) - (k.length[me] * 0.5f + k.length[other] * 0.5f);
+
+        // A merging vehicle can still sit between us and our lane leader
+        float mergeGap = 9999.0f;
+        int merging = FindAheadAtNode(k.targetNodeId[me], myRemaining, me, k, mergeGap);
+        if (merging >= 0 && mergeGap < gapOut) {
+            gapOut = mergeGap;
+            return merging;
+        }
+        return other;
+    }
 
-void TrafficManager::UpdateVehicles(std::vector<std::unique_ptr<Vehicle>>& vehicles, const RoadGraph& map) {
-    float dt = GetFrameTime();
-    
-    for (size_t i = 0; i < vehicles.size(); i++) {
-        Vehicle* current = vehicles[i].get();
-        if (current->finished) continue;
-
-        if (current->forceMoveTimer > 0.0f) current->forceMoveTimer -= dt;
-        
-        float targetSpeed = current->desiredSpeed;
-        bool emergencyStop = false; 
-        bool redLightStop = false;
-
-        // --- 1. TRAFFIC LIGHT LOGIC ---
-        for (const auto& ctrl : controllers) {
-            bool isManagedNode = false;
-            for (int nodeId : ctrl.nodeIds) {
-                if (current->targetNodeId == nodeId) {
-                    isManagedNode = true;
+    // B. Walk the graph ahead until 'range' is used up.
+    // A routed vehicle only follows its route; otherwise the next turn is only picked on arrival,
+    // so every branch is checked and the closest vehicle wins.
+    int leader = -1;
+    float bestGap = 9999.0f;
+    int route = routes ? k.routeId[me] : -1;
+
+    struct WalkStep { int nodeId; float dist; };
+    WalkStep stack[MAX_LANE_WALK_EDGES];
+    int top = 0;
+    int visited = 0;
+    stack[top++] = { k.targetNodeId[me], myRemaining };
+
+    while (top > 0 && visited < MAX_LANE_WALK_EDGES) {
+        WalkStep step = stack[--top];
+        visited++;
+
+        float gap = 9999.0f;
+        int ahead = FindAheadAtNode(step.nodeId, step.dist, me, k, gap);
+        if (ahead >= 0) {
+            if (gap < bestGap) {
+                bestGap = gap;
+                leader = ahead;
+            }
+            continue; // Nothing further on this branch can be closer
+        }
+
+        int node = map.IndexOf(step.nodeId);
+        if (map.TypeOf(node) == TELEPORT) continue; // Landing is checked by the teleport itself
+
+        NodeRange successors = map.Successors(node);
+        int routeNext = route >= 0 ? routes->NextNode(route, node) : -1;
+        if (route >= 0) successors = routeNext >= 0 ? NodeRange{ &routeNext, &routeNext + 1 } : NodeRange{ nullptr, nullptr };
+        for (int next : successors) {
+            int nextId = map.IdOf(next);
+            // Tail of the outgoing lane: edges are often longer than 'range', so look at its last vehicle directly
+            auto out = lanes.find(EdgeKey(step.nodeId, nextId));
+            int tail = -1;
+            if (out != lanes.end()) {
+                for (const LaneSlot& slot : out->second.slots) {
+                    int other = slot.vehicle;
+                    if (other == me || step.dist + slot.s <= 0.0f) continue;
+                    tail = other;
+                    gap = (step.dist + slot.s) - (k.length[me] * 0.5f + k.length[other] * 0.5f);
                     break;
                 }
             }
-
-            if (isManagedNode) {
-                if (ctrl.currentState == LIGHT_RED || ctrl.currentState == LIGHT_YELLOW) {
-                    
-                    Vector3 nodePos = {0,0,0};
-                    bool found = false;
-                    for(const auto& n : map.GetAllNodes()) {
-                        if(n.id == current->targetNodeId) {
-                            nodePos = n.pos;
-                            found = true;
-                            break;
-                        }
-                    }
-
-                    if (found) {
-                        float distToNode = GetDistance(current->position, nodePos); // Uses restored helper
-
-                        if (distToNode < startSlowingDist) {
-                            Vector3 toNode = Vector3Subtract(nodePos, current->position);
-                            if (Vector3DotProduct(current->forward, toNode) > 0) {
-                                redLightStop = true;
-                            }
-                        }
-                    }
+            if (tail >= 0) {
+                if (gap < bestGap) {
+                    bestGap = gap;
+                    leader = tail;
                 }
+                continue;
             }
-        }
 
-        if (redLightStop) emergencyStop = true;
-        
-        // --- 2. COLLISION LOGIC ---
-        float closestGap = 9999.0f;
-        Vehicle* closestVehicle = nullptr;
-        bool followMode = false;
-
-        float dynamicDetectionRange = detectionRange + (current->speed * 2.0f);
-        float dynamicSlowingDist = startSlowingDist + (current->speed * 1.5f);
-
-        for (size_t j = 0; j < vehicles.size(); j++) {
-            if (i == j) continue;
-            Vehicle* other = vehicles[j].get();
-            if (other->finished) continue;
-
-            float dist = GetDistance(current->position, other->position);
-            if (dist > dynamicDetectionRange) continue;
-
-            Vector3 toOther = Vector3Subtract(other->position, current->position);
-            float fwdDist = Vector3DotProduct(toOther, current->forward);
-            float sideDist = Vector3DotProduct(toOther, { -current->forward.z, 0, current->forward.x });
-            float combinedHalfLengths = (current->length * 0.5f) + (other->length * 0.5f);
-
-            // A. Check Direction
-            if (AreSameDirection(current->forward, other->forward)) { // Uses restored helper
-                // B. Check Lane
-                if (IsInMyLane(current, other)) { // Uses restored helper
-                    float physicalGap = dist - combinedHalfLengths;
-                    if (physicalGap < closestGap) {
-                        closestGap = physicalGap;
-                        closestVehicle = other;
-                        followMode = true;
-                    }
-                }
-            } 
-            else {
-                // Intersection logic
-                float safeCrossingDist = combinedHalfLengths + 3.0f + (current->speed * 0.5f);
-                if (fwdDist > 0 && fwdDist < safeCrossingDist && fabs(sideDist) < 2.5f) {
-                    emergencyStop = true;
-                }
+            float nextDist = step.dist + Vector3Distance(map.PositionOf(node), map.PositionOf(next));
+            if (nextDist < range && top < MAX_LANE_WALK_EDGES) {
+                stack[top++] = { nextId, nextDist };
             }
         }
+    }
 
-        // --- ANGRY MODE (NUCLEAR OPTION) ---
-        if (current->forceMoveTimer > 0.0f) {
-            targetSpeed = 18.0f;     // Force high speed
-            current->speed = 18.0f;  // Force physics velocity immediately
-            emergencyStop = false;  // Ignore obstacles
-            followMode = false;     // Ignore lead car
-        }
+    if (leader >= 0 && bestGap < range) {
+        gapOut = bestGap;
+        return leader;
+    }
+    return -1;
+}
 
-        else {
-            // CALM MODE
-            if (emergencyStop) {
-                targetSpeed = 0.0f;
-            }
-            else if (followMode) {
-                if (closestGap < minSafeDist) {
-                    targetSpeed = 0.0f;
-                }
-                else if (closestGap < dynamicSlowingDist) {
-                    // Using Lerp could be nice here, but keeping your original math for consistency
-                    // Or we can use the helper:
-                    // float factor = (closestGap - minSafeDist) / (dynamicSlowingDist - minSafeDist);
-                    // targetSpeed = Lerp(0.0f, current->desiredSpeed, factor);
-                    
-                    float factor = (closestGap - minSafeDist) / (dynamicSlowingDist - minSafeDist);
-                    if (closestVehicle) {
-                        targetSpeed = closestVehicle->speed + (current->desiredSpeed - closestVehicle->speed) * factor;
-                    } else {
-                        targetSpeed = current->desiredSpeed * factor;
-                    }
-                }
-            }
-            // Physics Smoothing
-            float acceleration = 10.0f;
-            float braking = 15.0f + (current->speed * 0.5f); 
+// =============================================================================
+//  UPDATE VEHICLES
+// =============================================================================
 
-            if (followMode && closestGap < minSafeDist + 2.0f && current->speed > 1.0f) {
-                braking = 50.0f; 
-            }
+void TrafficManager::UpdateVehicles(VehiclePool& vehicles, const RoadGraph& map, float dt, JobSystem* workers) {
+    VehicleKinematics& k = vehicles.GetKinematics();
+    BeginUpdate(k, map);
+    BuildGrid(k);
+    BuildLanes(k, map);
+
+    std::function<void(size_t, size_t)> updateRange = [&](size_t begin, size_t end) {
+        ComputeSpeeds(begin, end, k, map, dt);
+    };
+    if (workers) workers->ParallelFor(k.Size(), SimulationConfig::VEHICLE_BATCH, updateRange);
+    else updateRange(0, k.Size());
+    CommitSpeeds(k);
+}
+
+void TrafficManager::BeginUpdate(const VehicleKinematics& k, const RoadGraph& map) {
+    updateTime = clock ? clock->Now() : 0.0;
+    if (signalsDirty || signals.size() != (size_t)map.GetNodeCount()) BindSignals(map);
+
+    // --- DOUBLE BUFFER ---
+    // k.speed stays the previous tick while the new speeds go to nextSpeed:
+    // a vehicle never sees a neighbour that was already updated this tick
+    nextSpeed.resize(k.Size());
+    gapInput.resize(k.Size());
+    leaderSpeedInput.resize(k.Size());
+    speedMode.resize(k.Size());
+}
+
+void TrafficManager::BuildGrid(const VehicleKinematics& k) {
+    // Built once per tick so each vehicle only looks at the cells around it
+    gridPoints.resize(k.Size());
+    for (size_t i = 0; i < k.Size(); i++) {
+        gridPoints[i] = k.Position(i);
+    }
+    vehicleGrid.Build(gridPoints);
+}
+
+void TrafficManager::ComputeSpeeds(size_t begin, size_t end, const VehicleKinematics& k, const RoadGraph& map, float dt) {
+    // Neighbour search per vehicle, then the speed control of the whole range in SIMD batches
+    for (size_t i = begin; i < end; i++) GatherSpeedInput(i, k, map, updateTime);
+
+    SpeedControlInput in = { k.speed.data() + begin, k.desiredSpeed.data() + begin, gapInput.data() + begin,
+                             leaderSpeedInput.data() + begin, speedMode.data() + begin };
+    SpeedControlParams params = { minSafeDist, startSlowingDist, FORCED_SPEED, dt };
+    SpeedControlBatch(in, nextSpeed.data() + begin, end - begin, params);
+}
 
-            if (current->speed > targetSpeed) {
-                current->speed -= braking * dt;
-                if (current->speed < targetSpeed) current->speed = targetSpeed;
-            } 
-            else {
-                current->speed += acceleration * dt;
-                if (current->speed > targetSpeed) current->speed = targetSpeed;
+void TrafficManager::CommitSpeeds(VehicleKinematics& k) {
+    k.speed.swap(nextSpeed);
+}
+
+void TrafficManager::GatherSpeedInput(size_t i, const VehicleKinematics& k, const RoadGraph& map, double now) {
+    if (k.finished[i]) {
+        speedMode[i] = SPEED_FROZEN;
+        gapInput[i] = NO_LEADER_GAP;
+        leaderSpeedInput[i] = 0.0f;
+        return;
+    }
+    Vector3 position = k.Position(i);
+    Vector3 forward = k.Forward(i);
+    float speed = k.speed[i];
+    float length = k.length[i];
+
+    bool emergencyStop = false; 
+    bool redLightStop = false;
+
+    // --- 1. TRAFFIC LIGHT LOGIC ---
+    const SignalSlot& signal = signals[map.IndexOf(k.targetNodeId[i])];
+    if (signal.controller >= 0) {
+        LightState state = controllers[signal.controller].currentState;
+
+        if (state == LIGHT_RED || state == LIGHT_YELLOW) {
+            float distToNode = GetDistance(position, signal.stopLine); // Uses restored helper
+
+            if (distToNode < startSlowingDist) {
+                Vector3 toNode = Vector3Subtract(signal.stopLine, position);
+                if (Vector3DotProduct(forward, toNode) > 0) {
+                    redLightStop = true;
+                }
             }
         }
-        
-        if (current->speed < 0.0f) current->speed = 0.0f;
     }
-}
\ No newline at end of file
+
+    if (redLightStop) emergencyStop = true;
+    
+    // --- 2. COLLISION LOGIC ---
+    float closestGap = NO_LEADER_GAP;
+    int closestVehicle = -1;
+
+    float dynamicDetectionRange = detectionRange + (speed * 2.0f);
+
+    // A. Leader: next vehicle on our lane (or downstream lanes)
+    float leaderGap = 9999.0f;
+    int leader = FindLeader(i, k, map, dynamicDetectionRange, leaderGap);
+    if (leader >= 0) {
+        closestGap = leaderGap;
+        closestVehicle = leader;
+    }
+
+    // B. Crossing traffic (Only vehicles that are not going our way)
+    vehicleGrid.ForEachNear(position, dynamicDetectionRange, [&](int j) {
+        if ((size_t)j == i) return;
+        if (k.finished[j]) return;
+        if (j == leader) return;
+        // Vehicles on our edge, or coming up behind us into the node we just left, are lane traffic (handled in A)
+        if (k.targetNodeId[j] == k.targetNodeId[i] && k.currentNodeId[j] == k.currentNodeId[i]) return;
+        if (k.targetNodeId[j] == k.currentNodeId[i]) return;
+        if (AreSameDirection(forward, k.Forward(j))) return;
+
+        Vector3 otherPos = k.Position(j);
+        float dist = GetDistance(position, otherPos);
+        if (dist > dynamicDetectionRange) return;
+
+        Vector3 toOther = Vector3Subtract(otherPos, position);
+        float fwdDist = Vector3DotProduct(toOther, forward);
+        float sideDist = Vector3DotProduct(toOther, { -forward.z, 0, forward.x });
+        float combinedHalfLengths = (length * 0.5f) + (k.length[j] * 0.5f);
+
+        // Intersection logic
+        float safeCrossingDist = combinedHalfLengths + 3.0f + (speed * 0.5f);
+        if (fwdDist > 0 && fwdDist < safeCrossingDist && fabs(sideDist) < 2.5f) {
+            emergencyStop = true;
+        }
+    });
+
+    // --- 3. SPEED CONTROL INPUTS (the speed itself is computed in batches, see kinematics_kernel.h) ---
+    gapInput[i] = closestGap;
+    leaderSpeedInput[i] = closestVehicle >= 0 ? k.speed[closestVehicle] : 0.0f;
+    if (k.forceMoveUntil[i] > now) speedMode[i] = SPEED_FORCED;   // ANGRY MODE: ignore obstacles and lead car
+    else if (emergencyStop) speedMode[i] = SPEED_STOP;
+    else speedMode[i] = SPEED_CONTROL;
+}
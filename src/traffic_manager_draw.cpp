@@ -0,0 +1,64 @@
+#include "traffic_manager.h"
+#include "rlgl.h"
+#include "frustum.h"
+
+// =============================================================================
+//  DRAWING LOGIC
+// =============================================================================
+void TrafficManager::DrawTrafficLightModel(Vector3 pos, float angleY, LightState state) {
+    rlPushMatrix();
+    
+    // 1. Move to position
+    rlTranslatef(pos.x, pos.y, pos.z);
+    
+    // 2. Rotate to face the road
+    rlRotatef(angleY, 0, 1, 0);
+
+    // --- DRAWING IN LOCAL COORDINATES ---
+    
+    float poleHeight = 6.0f;
+    float armLength = 6.5f; 
+
+    // A. The Pole
+    // Note: Chaimae offsets the pole slightly (x=1.0) so the light hangs over 0.0
+    DrawCylinder({1.0f, 0.0f, 0.0f}, 0.3f, 0.3f, poleHeight, 16, DARKGRAY);
+
+    // B. The Horizontal Arm
+    Vector3 armStart = {1.0f, poleHeight - 0.5f, 0.0f};
+    Vector3 armEnd   = {1.0f - armLength, poleHeight - 0.5f, 0.0f};
+    DrawCylinderEx(armStart, armEnd, 0.2f, 0.2f, 8, DARKGRAY);
+
+    // C. The Light Box
+    Vector3 boxPos = armEnd;
+    float w=0.6f, h=1.8f, d=0.6f;
+    Vector3 boxCenter = {boxPos.x, boxPos.y - 0.8f, boxPos.z};
+    
+    DrawCube(boxCenter, w, h, d, BLACK);
+    DrawCubeWires(boxCenter, w, h, d, DARKGRAY); 
+
+    // D. The Lights (Red/Yellow/Green)
+    float zFace = boxCenter.z + (d/2) + 0.05f; 
+
+    // Colors: Dim if off, Bright if on
+    Color cRed    = (state == LIGHT_RED)    ? RED    : (Color){50, 0, 0, 255};   
+    Color cYellow = (state == LIGHT_YELLOW) ? ORANGE : (Color){50, 40, 0, 255};
+    Color cGreen  = (state == LIGHT_GREEN)  ? GREEN  : (Color){0, 50, 0, 255}; 
+
+    DrawSphere({boxCenter.x, boxCenter.y + 0.5f, zFace}, 0.22f, cRed);    // Top
+    DrawSphere({boxCenter.x, boxCenter.y,        zFace}, 0.22f, cYellow); // Middle
+    DrawSphere({boxCenter.x, boxCenter.y - 0.5f, zFace}, 0.22f, cGreen);  // Bottom
+    
+    rlPopMatrix();
+}
+
+// Bounding sphere of a light: 6 m pole with a 6.5 m arm, centered half way up
+static const float LIGHT_CULL_HEIGHT = 3.0f;
+static const float LIGHT_CULL_RADIUS = 7.5f;
+
+void TrafficManager::Draw(const Frustum& view) {
+    for (const auto& ctrl : controllers) {
+        Vector3 center = { ctrl.position.x, ctrl.position.y + LIGHT_CULL_HEIGHT, ctrl.position.z };
+        if (!view.IntersectsSphere(center, LIGHT_CULL_RADIUS)) continue;
+        DrawTrafficLightModel(ctrl.position, ctrl.rotation, ctrl.currentState);
+    }
+}
@@ -0,0 +1,38 @@
+#include "travel_times.h"
+#include "vehicle_state.h"
+#include "raymath.h"
+#include <algorithm>
+
+void TravelTimes::Reset(const RoadGraph& graph, float freeFlowSpeed) {
+    freeFlow.assign(graph.GetEdgeCount(), 0.0f);
+    for (int from = 0; from < graph.GetNodeCount(); from++) {
+        int e = graph.FirstEdge(from);
+        for (int to : graph.Successors(from)) {
+            freeFlow[e++] = Vector3Distance(graph.PositionOf(from), graph.PositionOf(to)) / freeFlowSpeed;
+        }
+    }
+    estimates = freeFlow;
+    observations = 0;
+}
+
+void TravelTimes::Observe(int edge, float seconds) {
+    estimates[edge] += (seconds - estimates[edge]) * SMOOTHING;
+    observations++;
+}
+
+void TravelTimes::Collect(VehicleKinematics& k) {
+    for (size_t i = 0; i < k.Size(); i++) {
+        if (k.doneEdge[i] < 0) continue;
+        Observe(k.doneEdge[i], k.doneTime[i]);
+        k.doneEdge[i] = -1;
+    }
+}
+
+void TravelTimes::Snapshot(const VehicleKinematics& k, const RoadGraph& graph, std::vector<float>& costs) const {
+    costs = estimates;
+    for (size_t i = 0; i < k.Size(); i++) {
+        if (k.finished[i] || k.edgeTime[i] <= 0.0f || k.currentNodeId[i] < 0) continue;
+        int edge = graph.FindEdge(graph.IndexOf(k.currentNodeId[i]), graph.IndexOf(k.targetNodeId[i]));
+        if (edge >= 0) costs[edge] = std::max(costs[edge], k.edgeTime[i]);
+    }
+}
@@ -1,368 +1,188 @@
 #include "vehicle.h"
-#include "rlgl.h"
+#include "vehicle_traits.h"
+#include "vehicle_pool.h"
+#include "route_planner.h"
 #include "raymath.h" // Important pour Vector3Normalize, etc.
-
-// Initialize static member
-ModelManager* Vehicle::modelManager = nullptr;
+#include "sim_random.h"
+#include "kinematics_kernel.h"
+#include <algorithm>
 
 // =============================================================================
 //  VEHICLE BASE CLASS
 // =============================================================================
 
-Vehicle::Vehicle(Vector3 pos, int initialTargetId) 
-    : position(pos), 
-      forward({1,0,0}), 
-      speed(5.0f), 
-      desiredSpeed(5.0f), 
-      length(4.0f), 
-      targetNodeId(initialTargetId), 
-      color(RED),
-      originalColor(RED),
-      forceMoveTimer(0.0f)
+Vehicle::Vehicle(VehicleType type) 
+    : color(GetVehicleTypeInfo(type).color),
+      originalColor(GetVehicleTypeInfo(type).color),
+      type(type)
       {}
 
 Vehicle::~Vehicle() {}
 
-// MISE À JOUR : Utilise RoadGraph au lieu de std::vector<Node>
-void Vehicle::update(float dt, RoadGraph &graph, const std::vector<std::unique_ptr<Vehicle>>& allVehicles) {
-
-    // 1. Récupération sécurisée du noeud cible via la classe RoadGraph
-    Node &targetNode = graph.GetNode(targetNodeId);
-    Vector3 targetPos = targetNode.pos;
-    
-    // 2. Calcul de la direction et distance
-    Vector3 dir = { targetPos.x - position.x, targetPos.y - position.y, targetPos.z - position.z };
-    float dist = sqrtf(dir.x*dir.x + dir.y*dir.y + dir.z*dir.z);
-    
-    // 3. LOGIQUE D'ARRIVÉE
-    if (dist < CONFIG::ARRIVAL_THRESHOLD) { // Threshold for "reaching" the node
-        
-        // TYPE A: TELEPORTATION
-        if (targetNode.type == TELEPORT) {
-            int startNodeId = targetNode.teleportTargetId;
-            Node &destinationNode = graph.GetNode(startNodeId);
-
-            // --- 1. CHECK IF LANDING ZONE IS CLEAR ---
-            bool isBlocked = false;
-
-            
-            
-            // Scan all vehicles to see if anyone is at the destination
-            for (const auto& other : allVehicles) {
-                // Don't check against self
-                if (other.get() == this) continue; 
-
-                // Check distance to the destination node
-                // 8.0f is a safe gap to ensure we don't spawn inside them
-                if (Vector3Distance(other->position, destinationNode.pos) < 8.0f) {
-                    isBlocked = true;
-                    break;
-                }
-            }
-
-            // --- 2. EXECUTE TELEPORT OR WAIT ---
-            if (!isBlocked) {
-                // CLEAR: Jump instantly
-                this->position = destinationNode.pos;
-                this->targetNodeId = destinationNode.nextNodes[0];
-                
-                // IMPORTANT: Reset direction immediately to face the new path
-                Node &nextNode = graph.GetNode(this->targetNodeId);
-                Vector3 newDir = Vector3Subtract(nextNode.pos, this->position);
-                this->forward = Vector3Normalize(newDir);
-            } 
-            else {
-                // BLOCKED: Stop and wait for the car ahead to move
-                this->speed = 0; 
-                return; 
-            }
-        }
-        
-        // TYPE B: NAVIGATION CLASSIQUE (DECISION, START, ARC)
-        else if (targetNode.type == DECISION || targetNode.type == START || targetNode.type == ARC) {
-            if (!targetNode.nextNodes.empty()) {
-                // Pick one of multiple paths randomly
-                int randomIndex = GetRandomValue(0, targetNode.nextNodes.size() - 1);
-                targetNodeId = targetNode.nextNodes[randomIndex];
-            }
-        }
-        return; // Exit update for this frame to prevent jitter
+// MISE À JOUR : Utilise RoadGraph et les tableaux SoA (ligne 'i')
+void Vehicle::Move(VehicleKinematics& k, size_t i, float dt, const RoadGraph &graph, OccupancyIndex& occupancy,
+                   const RouteTable* routes) {
+    if (Drive(k, i, dt, graph, routes)) Teleport(k, i, graph, occupancy, routes);
+}
+
+void Vehicle::Teleport(VehicleKinematics& k, size_t i, const RoadGraph &graph, OccupancyIndex& occupancy,
+                       const RouteTable* routes) {
+    int target = graph.IndexOf(k.targetNodeId[i]);
+    int destination = graph.TeleportTargetOf(target);
+    Vector3 destinationPos = graph.PositionOf(destination);
+
+    // --- 1. CHECK IF LANDING ZONE IS CLEAR ---
+    // Nobody within NODE_CLEAR_RADIUS of the destination (we are at the teleport, far from it)
+    bool isBlocked = !occupancy.IsClear(destination);
+
+    // --- 2. EXECUTE TELEPORT OR WAIT ---
+    if (!isBlocked) {
+        // CLEAR: Jump instantly
+        // Trip done: next trip from the landing node (or the first edge without a route)
+        int route = routes ? routes->PickFrom(destination, k.routeSeed[i]) : -1;
+        int next = route >= 0 ? routes->NextNode(route, destination) : graph.Successors(destination)[0];
+        k.routeId[i] = route;
+        k.edgeTime[i] = 0.0f;
+        k.SetPosition(i, destinationPos);
+        k.currentNodeId[i] = graph.IdOf(destination);
+        k.targetNodeId[i] = graph.IdOf(next);
+        
+        // IMPORTANT: Reset direction immediately to face the new path
+        Vector3 newDir = Vector3Subtract(graph.PositionOf(next), destinationPos);
+        k.SetForward(i, Vector3Normalize(newDir));
+        k.SnapPreviousPose(i);
+        occupancy.MarkArrival(destination);
+    } 
+    else {
+        // BLOCKED: Stop and wait for the car ahead to move
+        k.speed[i] = 0; 
     }
-
-    // 4. LOGIQUE DE MOUVEMENT
-        // A- Normalize direction vector (using the dist we calculated earlier)
-        if (dist > 0) {
-            dir.x /= dist; 
-            dir.y /= dist; 
-            dir.z /= dist;
-        }
-
-        // B- Smooth Steering (Interpolate forward vector toward direction)
-        float turnRate = 12.0f * dt;
-        forward.x += (dir.x - forward.x) * turnRate;
-        forward.z += (dir.z - forward.z) * turnRate;
-
-        // C- Re-normalize forward vector to keep speed consistent
-        float fMag = sqrtf(forward.x*forward.x + forward.z*forward.z);
-        if (fMag > 0) { 
-            forward.x /= fMag; 
-            forward.z /= fMag; 
-        }
-
-        // D- Apply velocity to position
-        position.x += forward.x * speed * dt;
-        position.y += forward.y * speed * dt;
-        position.z += forward.z * speed * dt;
-}
-
-void Vehicle::draw() {
-    float angle = atan2f(forward.x, forward.z) * RAD2DEG;
-    rlPushMatrix();
-    rlTranslatef(position.x, position.y, position.z);
-    rlRotatef(angle, 0, 1, 0);
-    DrawCube({0,0,0}, 2.0f, 0.6f, 4.0f, color); 
-    DrawCubeWires({0,0,0}, 2.0f, 0.6f, 4.0f, BLACK);
-    rlPopMatrix();
-}
-
-void DrawWheel3D(float x, float y, float z, float radius = 0.3f, float width = 0.4f) {
-    rlPushMatrix();
-        rlTranslatef(x, y, z);
-        // Rotate 90 deg around Z so the cylinder lays flat sideways
-        rlRotatef(90, 0, 0, 1); 
-        // Note: Raylib draws cylinder centered at (0,0,0). 
-        // The rotation pivots it correctly.
-        DrawCylinder((Vector3){0,0,0}, radius, radius, width, 16, BLACK);
-        DrawCylinderWires((Vector3){0,0,0}, radius, radius, width, 16, DARKGRAY);
-        
-        // Hubcap (Visual detail to see rotation)
-        DrawCylinder((Vector3){0, width/2.0f + 0.01f, 0}, radius*0.5f, radius*0.5f, 0.05f, 8, LIGHTGRAY);
-    rlPopMatrix();
-}
-
-// =============================================================================
-//  CAR IMPLEMENTATION
-// =============================================================================
-
-Car::Car(Vector3 pos, int targetId) : Vehicle(pos, targetId) { 
-    color = BLUE; 
-    originalColor = BLUE;
-    desiredSpeed = CONFIG::CAR_SPEED; 
-    speed = desiredSpeed;
-    length = 4.5f; // Standard Car Length
-}
-
-void Car::draw() {
-    if (!modelManager) return; // Safety check
-
-    float angle = atan2f(forward.x, forward.z) * RAD2DEG;
-
-    Model& carModel = modelManager->GetModel("Car");
-    
-    rlPushMatrix();
-        rlTranslatef(position.x, position.y, position.z);
-        rlRotatef(angle, 0, 1, 0);
-        
-        // Adjust scale and height as needed
-        rlScalef(1.0f, 1.0f, 1.0f);
-        
-        // Apply vehicle color to the model
-        carModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
-        
-        DrawModel(carModel, (Vector3){0, 0, 0}, 1.0f, WHITE);
-    rlPopMatrix();
-}
-
-// =============================================================================
-//  BUS IMPLEMENTATION
-// =============================================================================
-
-Bus::Bus(Vector3 pos, int targetId) : Vehicle(pos, targetId) { 
-    color = GOLD;
-    originalColor = GOLD;
-    desiredSpeed = CONFIG::BUS_SPEED;
-    speed = desiredSpeed; 
-    length = 8.5f;
 }
 
-void Bus::draw() {
-    if (!modelManager) return; // Safety check
-
-    float angle = atan2f(forward.x, forward.z) * RAD2DEG;
-
-    Model& busModel = modelManager->GetModel("Bus");
-    
-    rlPushMatrix();
-        rlTranslatef(position.x, position.y, position.z);
-        rlRotatef(angle, 0, 1, 0);
-        
-        // Adjust scale and height as needed
-        rlScalef(1.0f, 1.0f, 1.0f);
-        
-        // Apply vehicle color to the model
-        busModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
-        
-        DrawModel(busModel, (Vector3){0, 0, 0}, 1.0f, WHITE);
-    rlPopMatrix();
-}
+bool Vehicle::Drive(VehicleKinematics& k, size_t i, float dt, const RoadGraph &graph, const RouteTable* routes) {
+    if (k.finished[i]) return false;
 
-// =============================================================================
-//  TRUCK IMPLEMENTATION
-// =============================================================================
-
-Truck::Truck(Vector3 pos, int targetId) : Vehicle(pos, targetId) { 
-    color = (Color){139, 69, 19, 255}; // Brun
-    originalColor = (Color){139, 69, 19, 255};
-    desiredSpeed = CONFIG::TRUCK_SPEED;
-    speed = desiredSpeed;
-    length = 10.0f; // Truck is the longest
-}
-
-void Truck::draw() {
-    if (!modelManager) return; // Safety check
-
-    float angle = atan2f(forward.x, forward.z) * RAD2DEG;
-
-    Model& truckModel = modelManager->GetModel("Truck");
-    
-    rlPushMatrix();
-        rlTranslatef(position.x, position.y, position.z);
-        rlRotatef(angle, 0, 1, 0);
-        
-        // Adjust scale and height as needed
-        rlScalef(1.0f, 1.0f, 1.0f);
-        
-        // Apply vehicle color to the model
-        truckModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
-        
-        DrawModel(truckModel, (Vector3){0, 0, 0}, 1.0f, WHITE);
-    rlPopMatrix();
-}
+    // 1. Récupération sécurisée du noeud cible via la classe RoadGraph
+    Vector3 targetPos = graph.PositionOf(graph.IndexOf(k.targetNodeId[i]));
 
-// =============================================================================
-//  TAXI IMPLEMENTATION
-// =============================================================================
+    // 2. Direction, arrivée et mouvement (même calcul que la version SIMD, voir kinematics_kernel.h)
+    float targetX = targetPos.x, targetY = targetPos.y, targetZ = targetPos.z;
+    int32_t active = 1;
+    unsigned char arrived = 0;
+    SteeringArrays one = { &k.posX[i], &k.posY[i], &k.posZ[i], &k.fwdX[i], &k.fwdZ[i], &k.speed[i],
+                           &targetX, &targetY, &targetZ, &active, &arrived };
+    SteerScalar(one, 1, dt, CONFIG::ARRIVAL_THRESHOLD);
+    if (k.edgeTime[i] >= 0.0f) k.edgeTime[i] += dt;
 
-Taxi::Taxi(Vector3 pos, int targetId) : Vehicle(pos, targetId) { 
-    color = YELLOW;
-    originalColor = YELLOW;
-    desiredSpeed = CONFIG::TAXI_SPEED;
-    speed = desiredSpeed;
-    length = 4.5f;
+    // 3. LOGIQUE D'ARRIVÉE
+    return arrived ? Arrive(k, i, graph, routes) : false;
 }
 
-void Taxi::update(float dt, RoadGraph &graph, const std::vector<std::unique_ptr<Vehicle>> &allVehicles) {
-    Vehicle::update(dt, graph, allVehicles); 
-    signBlinkTimer += dt;
-}
+bool Vehicle::Arrive(VehicleKinematics& k, size_t i, const RoadGraph &graph, const RouteTable* routes) {
+    int target = graph.IndexOf(k.targetNodeId[i]);
+    Vector3 targetPos = graph.PositionOf(target);
 
-void Taxi::draw() {
-    if (!modelManager) return; // Safety check
+    // Threshold for "reaching" the node, or a step long enough to pass it (large dt): no orbiting the node
+    if (Vector3Distance(k.Position(i), targetPos) >= CONFIG::ARRIVAL_THRESHOLD) {
+        k.SetPosition(i, targetPos);
+    }
 
-    float angle = atan2f(forward.x, forward.z) * RAD2DEG;
+    // Edge driven: its travel time is reported once (TravelTimes), even if the vehicle then waits here
+    if (k.edgeTime[i] >= 0.0f && k.currentNodeId[i] >= 0) {
+        k.doneEdge[i] = graph.FindEdge(graph.IndexOf(k.currentNodeId[i]), target);
+        k.doneTime[i] = k.edgeTime[i];
+    }
+    k.edgeTime[i] = -1.0f;
 
-    Model& taxiModel = modelManager->GetModel("Taxi");
-    
-    rlPushMatrix();
-        rlTranslatef(position.x, position.y, position.z);
-        rlRotatef(angle, 0, 1, 0);
-        
-        // Adjust scale and height as needed
-        rlScalef(1.0f, 1.0f, 1.0f);
-        
-        // Apply vehicle color to the model
-        taxiModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
-        
-        DrawModel(taxiModel, (Vector3){0, 0, 0}, 1.0f, WHITE);
-    rlPopMatrix();
-}
+    // TYPE A: TELEPORTATION (landing resolved by Teleport, in vehicle order)
+    if (graph.TypeOf(target) == TELEPORT) {
+        return true;
+    }
+    k.edgeTime[i] = 0.0f; // Next edge starts now
+
+    // TYPE B: ROUTE PLANIFIÉE (RoutePlanner): next node on the way to the route's destination,
+    // read from the current routes (they follow the traffic, see RouteRefresher)
+    if (routes && k.routeId[i] >= 0) {
+        int next = routes->NextNode(k.routeId[i], target);
+        if (next >= 0) {
+            k.currentNodeId[i] = k.targetNodeId[i];
+            k.targetNodeId[i] = graph.IdOf(next);
+        }
+        else {
+            k.finished[i] = 1; // Destination without teleport: the vehicle leaves the network
+        }
+        return false;
+    }
 
-// =============================================================================
-//  POLICE CAR IMPLEMENTATION
-// =============================================================================
+    // TYPE C: NAVIGATION CLASSIQUE (DECISION, START, ARC)
+    NodeRange next = graph.Successors(target);
+    if (!next.empty()) {
+        // Pick one of multiple paths randomly (per-vehicle generator: independent of update order)
+        SimRandom rng(k.routeSeed[i]);
+        int randomIndex = rng.Range(0, (int)next.size() - 1);
+        k.routeSeed[i] = rng.state;
+        k.currentNodeId[i] = k.targetNodeId[i];
+        k.targetNodeId[i] = graph.IdOf(next[randomIndex]);
+    }
+    else {
+        // Dead end: the vehicle leaves the network (reclaimed by the pool)
+        k.finished[i] = 1;
+    }
+    return false; // No move on the arrival tick (prevents jitter)
+}
+
+void Vehicle::DriveRange(VehicleKinematics& k, size_t begin, size_t end, float dt, const RoadGraph &graph,
+                         DriveScratch& scratch, unsigned char* atTeleport, const RouteTable* routes) {
+    // Target positions gathered from the graph, then the whole range steered at once
+    for (size_t i = begin; i < end; i++) {
+        scratch.active[i] = k.finished[i] ? 0 : 1;
+        Vector3 targetPos = k.finished[i] ? k.Position(i) : graph.PositionOf(graph.IndexOf(k.targetNodeId[i]));
+        scratch.targetX[i] = targetPos.x;
+        scratch.targetY[i] = targetPos.y;
+        scratch.targetZ[i] = targetPos.z;
+    }
 
-PoliceCar::PoliceCar(Vector3 pos, int targetId) : Vehicle(pos, targetId) { 
-    color = (Color){20, 20, 120, 255}; // Bleu foncé
-    originalColor = (Color){20, 20, 120, 255};
-    desiredSpeed = CONFIG::POLICE_SPEED;
-    speed = desiredSpeed;
-    length = 4.5f;
-}
+    SteeringArrays rows = { k.posX.data() + begin, k.posY.data() + begin, k.posZ.data() + begin,
+                            k.fwdX.data() + begin, k.fwdZ.data() + begin, k.speed.data() + begin,
+                            scratch.targetX.data() + begin, scratch.targetY.data() + begin, scratch.targetZ.data() + begin,
+                            scratch.active.data() + begin, scratch.arrived.data() + begin };
+    SteerBatch(rows, end - begin, dt, CONFIG::ARRIVAL_THRESHOLD);
 
-void PoliceCar::update(float dt, RoadGraph &graph, const std::vector<std::unique_ptr<Vehicle>> &allVehicles) {
-    Vehicle::update(dt, graph, allVehicles); 
-    sirenTimer += dt;
+    for (size_t i = begin; i < end; i++) {
+        if (k.edgeTime[i] >= 0.0f && !k.finished[i]) k.edgeTime[i] += dt;
+        atTeleport[i] = (scratch.arrived[i] && Arrive(k, i, graph, routes)) ? 1 : 0;
+    }
 }
 
-void PoliceCar::draw() {
-    if (!modelManager) return; // Safety check
-
-    float angle = atan2f(forward.x, forward.z) * RAD2DEG;
-
-    Model& policeModel = modelManager->GetModel("Police");
-    
-    rlPushMatrix();
-        rlTranslatef(position.x, position.y, position.z);
-        rlRotatef(angle, 0, 1, 0);
-        
-        // Adjust scale and height as needed
-        rlScalef(1.0f, 1.0f, 1.0f);
-        
-        // Apply vehicle color to the model
-        policeModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
-
-        DrawModel(policeModel, (Vector3){0, 0, 0}, 1.0f, WHITE);
-    rlPopMatrix();
+void Vehicle::AnimateRange(VehiclePool& pool, size_t begin, size_t end, float dt) {
+    const VehicleKinematics& k = pool.GetKinematics();
+    ForEachVehicleType([&](auto tag) {
+        typedef typename decltype(tag)::type T;
+        if (!VehicleTraits<T>::ANIMATED) return;
+        size_t first = std::max(begin, pool.GroupBegin(VehicleTraits<T>::TYPE));
+        size_t last = std::min(end, pool.GroupEnd(VehicleTraits<T>::TYPE));
+        for (size_t i = first; i < last; i++) {
+            VehicleTraits<T>::Animate(pool.As<T>(i), k, i, dt);
+        }
+    });
 }
 
-// =============================================================================
-//  MOTORCYCLE IMPLEMENTATION
-// =============================================================================
-
-Motorcycle::Motorcycle(Vector3 pos, int targetId) : Vehicle(pos, targetId) { 
-    color = (Color){50, 50, 50, 255}; // Gris foncé
-    originalColor = (Color){50, 50, 50, 255};
-    desiredSpeed = CONFIG::MOTORCYCLE_SPEED;
-    speed = desiredSpeed;
-    length = 2.5f; // Shortest vehicle
-    lastForward = forward;
+void Vehicle::AnimatedRows(const VehiclePool& pool, size_t& first, size_t& end) {
+    first = end = 0;
+    bool any = false;
+    ForEachVehicleType([&](auto tag) {
+        typedef typename decltype(tag)::type T;
+        if (!VehicleTraits<T>::ANIMATED) return;
+        if (!any) first = pool.GroupBegin(VehicleTraits<T>::TYPE);
+        end = pool.GroupEnd(VehicleTraits<T>::TYPE);
+        any = true;
+    });
 }
 
-void Motorcycle::update(float dt, RoadGraph &graph, const std::vector<std::unique_ptr<Vehicle>> &allVehicles) {
-    Vector3 prevForward = lastForward;
-    
-    // Utilise votre logique de navigation RoadGraph
-    Vehicle::update(dt, graph, allVehicles);
-
-    // Calcul de l'inclinaison basé sur le changement de direction
-    float turnRate = (forward.x - prevForward.x) + (forward.z - prevForward.z);
-    tiltAngle = turnRate * 30.0f;
-    
-    // Limitation de l'angle d'inclinaison
-    if (tiltAngle > 25.0f) tiltAngle = 25.0f;
-    if (tiltAngle < -25.0f) tiltAngle = -25.0f;
-    
-    tiltAngle *= 0.9f; // Amortissement pour plus de fluidité
-    lastForward = forward;
+void DriveScratch::Resize(size_t count) {
+    targetX.resize(count);
+    targetY.resize(count);
+    targetZ.resize(count);
+    active.resize(count);
+    arrived.resize(count);
 }
-
-void Motorcycle::draw() {
-    if (!modelManager) return; // Safety check
-
-    float angle = atan2f(forward.x, forward.z) * RAD2DEG;
-
-    Model& motorcycleModel = modelManager->GetModel("Motorcycle");
-    
-    rlPushMatrix();
-        rlTranslatef(position.x, position.y, position.z);
-        rlRotatef(angle, 0, 1, 0);
-        
-        // Adjust scale and height as needed
-        rlScalef(1.0f, 1.0f, 1.0f);
-        
-        // Apply vehicle color to the model
-        motorcycleModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
-
-        DrawModel(motorcycleModel, (Vector3){0, 0, 0}, 1.0f, WHITE);
-    rlPopMatrix();
-}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "vehicle.h"
+#include "vehicle_pool.h"
+#include "model_manager.h"
+#include "vehicle_renderer.h"
+#include "rlgl.h"
+
+// Rendering side of the vehicles (not part of the headless core)
+
+// Initialize static member
+ModelManager* Vehicle::modelManager = nullptr;
+
+void DrawWheel3D(float x, float y, float z, float radius = 0.3f, float width = 0.4f) {
+    rlPushMatrix();
+        rlTranslatef(x, y, z);
+        // Rotate 90 deg around Z so the cylinder lays flat sideways
+        rlRotatef(90, 0, 0, 1);
+        // Note: Raylib draws cylinder centered at (0,0,0).
+        // The rotation pivots it correctly.
+        DrawCylinder((Vector3){0,0,0}, radius, radius, width, 16, BLACK);
+        DrawCylinderWires((Vector3){0,0,0}, radius, radius, width, 16, DARKGRAY);
+
+        // Hubcap (Visual detail to see rotation)
+        DrawCylinder((Vector3){0, width/2.0f + 0.01f, 0}, radius*0.5f, radius*0.5f, 0.05f, 8, LIGHTGRAY);
+    rlPopMatrix();
+}
+
+template <typename T> static float TiltOf(const T&) { return 0.0f; }
+static float TiltOf(const Motorcycle& moto) { return moto.tiltAngle; }
+
+// Bounding sphere radius around a vehicle's position: the models are up to ~1.5x the simulated
+// length (see VEHICLE_TYPE_LIST), plus a margin
+static float CullRadius(VehicleType type) {
+    return GetVehicleTypeInfo(type).length * 0.75f + 1.0f;
+}
+
+template <typename T>
+static void DrawGroup(const VehiclePool& pool, size_t begin, size_t end, float alpha, const Frustum& view,
+                      VehicleRenderer* instancing) {
+    if (begin == end) return;
+    const VehicleKinematics& kin = pool.GetKinematics();
+    float radius = CullRadius(VehicleTraits<T>::TYPE);
+
+    // Plain boxes without a model manager
+    Model* model = Vehicle::modelManager ? &Vehicle::modelManager->GetModel(VehicleTraits<T>::TYPE) : nullptr;
+
+    for (size_t i = begin; i < end; i++) {
+        const T& v = pool.As<T>(i);
+        Vector3 position = kin.InterpolatedPosition(i, alpha);
+        if (!view.IntersectsSphere(position, radius)) continue;
+        Vector3 forward = kin.InterpolatedForward(i, alpha);
+        float angle = atan2f(forward.x, forward.z) * RAD2DEG;
+
+        if (instancing) {
+            // Same frame as below: lean, then heading, then position
+            Matrix pose = MatrixMultiply(MatrixMultiply(MatrixRotateZ(TiltOf(v) * DEG2RAD), MatrixRotateY(angle * DEG2RAD)),
+                                         MatrixTranslate(position.x, position.y, position.z));
+            instancing->Add(VehicleTraits<T>::TYPE, pool.HandleAt(i), pose, v.color);
+            continue;
+        }
+
+        rlPushMatrix();
+            rlTranslatef(position.x, position.y, position.z);
+            rlRotatef(angle, 0, 1, 0);
+            rlRotatef(TiltOf(v), 0, 0, 1); // Roll around the heading (motorcycle lean)
+
+            if (model) {
+                // Apply vehicle color to the model
+                model->materials[0].maps[MATERIAL_MAP_DIFFUSE].color = v.color;
+                DrawModel(*model, (Vector3){0, 0, 0}, 1.0f, WHITE);
+            }
+            else {
+                DrawCube({0,0,0}, 2.0f, 0.6f, 4.0f, v.color);
+                DrawCubeWires({0,0,0}, 2.0f, 0.6f, 4.0f, BLACK);
+            }
+        rlPopMatrix();
+    }
+}
+
+void Vehicle::DrawAll(const VehiclePool& pool, float alpha, const Frustum& view, VehicleRenderer* instancing) {
+    if (instancing && !instancing->IsLoaded()) instancing = nullptr;
+    if (instancing) instancing->Begin(view);
+    ForEachVehicleType([&](auto tag) {
+        typedef typename decltype(tag)::type T;
+        DrawGroup<T>(pool, pool.GroupBegin(VehicleTraits<T>::TYPE), pool.GroupEnd(VehicleTraits<T>::TYPE), alpha, view, instancing);
+    });
+    if (instancing) instancing->Flush();
+}
@@ -0,0 +1,103 @@
+#include "vehicle_lod.h"
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+VehicleLod SelectVehicleLod(VehicleLod current, float distance, const VehicleLodConfig& config) {
+    const float start[VEHICLE_LOD_COUNT] = { 0.0f, config.reducedDistance, config.boxDistance };
+    int level = VEHICLE_LOD_FULL;
+    for (int k = 1; k < VEHICLE_LOD_COUNT; k++) {
+        // Leaving a level needs the same margin as entering it
+        float edge = (current >= k) ? start[k] - config.hysteresis : start[k] + config.hysteresis;
+        if (distance > edge) level = k;
+    }
+    return (VehicleLod)level;
+}
+
+// Sums of the vertices merged into one cell
+struct Cluster {
+    float position[3] = {};
+    float normal[3] = {};
+    float texcoord[2] = {};
+    float color[4] = {};
+    int count = 0;
+    int output = -1;   // Index in the simplified mesh, -1 while no kept triangle uses it
+};
+
+// 21 bits per axis, cells offset so that negative coordinates pack too
+static uint64_t CellKey(const float* p, float cellSize) {
+    const int64_t OFFSET = 1 << 20;
+    uint64_t key = 0;
+    for (int a = 0; a < 3; a++) {
+        int64_t cell = (int64_t)floorf(p[a] / cellSize) + OFFSET;
+        key = (key << 21) | ((uint64_t)cell & 0x1FFFFF);
+    }
+    return key;
+}
+
+Mesh SimplifyMesh(const Mesh& mesh, float cellSize) {
+    Mesh result = {};
+    if (!mesh.vertices || mesh.vertexCount <= 0 || cellSize <= 0.0f) return result;
+
+    // 1. Cluster of every vertex
+    std::unordered_map<uint64_t, int> clusterOfCell;
+    std::vector<Cluster> clusters;
+    std::vector<int> clusterOf(mesh.vertexCount);
+    for (int v = 0; v < mesh.vertexCount; v++) {
+        const float* p = &mesh.vertices[v * 3];
+        auto found = clusterOfCell.emplace(CellKey(p, cellSize), (int)clusters.size());
+        if (found.second) clusters.emplace_back();
+        Cluster& c = clusters[found.first->second];
+        for (int a = 0; a < 3; a++) c.position[a] += p[a];
+        if (mesh.normals) for (int a = 0; a < 3; a++) c.normal[a] += mesh.normals[v * 3 + a];
+        if (mesh.texcoords) for (int a = 0; a < 2; a++) c.texcoord[a] += mesh.texcoords[v * 2 + a];
+        if (mesh.colors) for (int a = 0; a < 4; a++) c.color[a] += mesh.colors[v * 4 + a];
+        c.count++;
+        clusterOf[v] = found.first->second;
+    }
+
+    // 2. Triangles whose corners stay in 3 different cells (the others collapsed to a line or a point)
+    int triangleCount = mesh.indices ? mesh.triangleCount : mesh.vertexCount / 3;
+    std::vector<int> kept;
+    int outputCount = 0;
+    for (int t = 0; t < triangleCount; t++) {
+        int corner[3];
+        for (int k = 0; k < 3; k++) {
+            int v = mesh.indices ? mesh.indices[t * 3 + k] : t * 3 + k;
+            corner[k] = clusterOf[v];
+        }
+        if (corner[0] == corner[1] || corner[1] == corner[2] || corner[0] == corner[2]) continue;
+        for (int k = 0; k < 3; k++) {
+            Cluster& c = clusters[corner[k]];
+            if (c.output < 0) c.output = outputCount++;
+            kept.push_back(c.output);
+        }
+    }
+    // Indices are 16 bits (like raylib's)
+    if (kept.empty() || outputCount > 65535) return result;
+
+    // 3. One vertex per used cluster, at the average of its vertices
+    result.vertexCount = outputCount;
+    result.triangleCount = (int)kept.size() / 3;
+    result.vertices = (float*)RL_CALLOC(outputCount * 3, sizeof(float));
+    if (mesh.normals) result.normals = (float*)RL_CALLOC(outputCount * 3, sizeof(float));
+    if (mesh.texcoords) result.texcoords = (float*)RL_CALLOC(outputCount * 2, sizeof(float));
+    if (mesh.colors) result.colors = (unsigned char*)RL_CALLOC(outputCount * 4, sizeof(unsigned char));
+    result.indices = (unsigned short*)RL_CALLOC(kept.size(), sizeof(unsigned short));
+
+    for (const Cluster& c : clusters) {
+        if (c.output < 0) continue;
+        int o = c.output;
+        float inv = 1.0f / c.count;
+        for (int a = 0; a < 3; a++) result.vertices[o * 3 + a] = c.position[a] * inv;
+        if (result.normals) {
+            float length = sqrtf(c.normal[0] * c.normal[0] + c.normal[1] * c.normal[1] + c.normal[2] * c.normal[2]);
+            for (int a = 0; a < 3; a++) result.normals[o * 3 + a] = length > 0.0f ? c.normal[a] / length : (a == 1 ? 1.0f : 0.0f);
+        }
+        if (result.texcoords) for (int a = 0; a < 2; a++) result.texcoords[o * 2 + a] = c.texcoord[a] * inv;
+        if (result.colors) for (int a = 0; a < 4; a++) result.colors[o * 4 + a] = (unsigned char)(c.color[a] * inv + 0.5f);
+    }
+    for (size_t i = 0; i < kept.size(); i++) result.indices[i] = (unsigned short)kept[i];
+    return result;
+}
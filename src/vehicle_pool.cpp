@@ -0,0 +1,122 @@
+#include "vehicle_pool.h"
+#include <utility>
+
+VehiclePool::~VehiclePool() {
+    Clear();
+}
+
+void VehiclePool::AddChunk() {
+    int first = GetCapacity();
+    chunks.emplace_back(new Slot[CHUNK_SLOTS]);
+
+    // Pushed in reverse so the lowest slot is handed out first
+    for (int i = CHUNK_SLOTS - 1; i >= 0; i--) freeSlots.push_back(first + i);
+}
+
+void VehiclePool::Reserve(int capacity) {
+    while (GetCapacity() < capacity) AddChunk();
+    live.reserve(capacity);
+    liveSlot.reserve(capacity);
+    kin.Reserve(capacity);
+}
+
+int VehiclePool::AcquireSlot() {
+    if (freeSlots.empty()) AddChunk();
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+    return slot;
+}
+
+int VehiclePool::IndexOf(VehicleHandle handle) const {
+    if (handle.slot < 0 || handle.slot >= GetCapacity()) return -1;
+    const Slot& s = SlotAt(handle.slot);
+    if (s.dense < 0 || s.generation != handle.generation) return -1;
+    return s.dense;
+}
+
+Vehicle* VehiclePool::Get(VehicleHandle handle) const {
+    int dense = IndexOf(handle);
+    return dense < 0 ? nullptr : live[dense];
+}
+
+void VehiclePool::SwapRows(size_t a, size_t b) {
+    if (a == b) return;
+    std::swap(live[a], live[b]);
+    std::swap(liveSlot[a], liveSlot[b]);
+    SlotAt(liveSlot[a]).dense = (int)a;
+    SlotAt(liveSlot[b]).dense = (int)b;
+    kin.SwapRows(a, b);
+}
+
+typedef VehicleHandle (VehiclePool::*CreateFunction)(const VehicleState&);
+static const CreateFunction CREATE_BY_TYPE[VEHICLE_TYPE_COUNT] = {
+#define X(ID, CLASS, ...) &VehiclePool::Create<CLASS>,
+    VEHICLE_TYPE_LIST(X)
+#undef X
+};
+
+VehicleHandle VehiclePool::Create(VehicleType type, const VehicleState& state) {
+    if (type >= VEHICLE_TYPE_COUNT) return VehicleHandle();
+    return (this->*CREATE_BY_TYPE[type])(state);
+}
+
+size_t VehiclePool::MoveLastIntoGroup(VehicleType type) {
+    // Every following group moves one row up: its first row goes to its end (the hole)
+    size_t row = live.size() - 1;
+    groupStart[VEHICLE_TYPE_COUNT] = live.size();
+    for (int g = VEHICLE_TYPE_COUNT - 1; g > type; g--) {
+        SwapRows(row, groupStart[g]);
+        row = groupStart[g];
+        groupStart[g]++;
+    }
+    return row;
+}
+
+void VehiclePool::RemoveAt(size_t denseIndex) {
+    int group = 0;
+    while (groupStart[group + 1] <= denseIndex) group++;
+
+    // The vehicle goes to the end of its group, then through the following groups
+    // (their last row takes the hole at their front) up to the last row
+    size_t row = denseIndex;
+    for (int g = group; g < VEHICLE_TYPE_COUNT; g++) {
+        size_t last = groupStart[g + 1] - 1;
+        SwapRows(row, last);
+        row = last;
+        groupStart[g + 1]--;
+    }
+
+    int slot = liveSlot[row];
+    Slot& s = SlotAt(slot);
+    live[row]->~Vehicle();
+    s.dense = -1;
+    s.generation++;   // Invalidates every handle to this vehicle
+    freeSlots.push_back(slot);
+
+    live.pop_back();
+    liveSlot.pop_back();
+    kin.PopBack();
+}
+
+void VehiclePool::Destroy(VehicleHandle handle) {
+    if (!Get(handle)) return;
+    RemoveAt(SlotAt(handle.slot).dense);
+}
+
+int VehiclePool::RemoveFinished(int* removedByType) {
+    int removed = 0;
+    for (size_t i = 0; i < live.size(); ) {
+        if (kin.finished[i]) {
+            if (removedByType) removedByType[live[i]->type]++;
+            RemoveAt(i); // Re-check 'i': it now holds a vehicle from further down
+            removed++;
+        } else {
+            i++;
+        }
+    }
+    return removed;
+}
+
+void VehiclePool::Clear() {
+    while (!live.empty()) RemoveAt(live.size() - 1);
+}
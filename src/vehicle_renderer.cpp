@@ -0,0 +1,218 @@
+#include "vehicle_renderer.h"
+#include "model_manager.h"
+#include "rlgl.h"
+#include <cmath>
+#include <iostream>
+
+// --- Instancing shader: same output as raylib's default shader (texture * colDiffuse * vertex
+// color), times the instance color, with the model matrix per instance ---
+#if defined(PLATFORM_DESKTOP)
+static const char* VEHICLE_VS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec4 vertexColor;\n"
+    "in mat4 instanceTransform;\n"
+    "in vec4 instanceColor;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragColor = vertexColor * instanceColor;\n"
+    "    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+static const char* VEHICLE_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    finalColor = texture(texture0, fragTexCoord) * colDiffuse * fragColor;\n"
+    "}\n";
+#else   // OpenGL ES 2 / WebGL
+static const char* VEHICLE_VS =
+    "#version 100\n"
+    "attribute vec3 vertexPosition;\n"
+    "attribute vec2 vertexTexCoord;\n"
+    "attribute vec4 vertexColor;\n"
+    "attribute mat4 instanceTransform;\n"
+    "attribute vec4 instanceColor;\n"
+    "uniform mat4 mvp;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragColor = vertexColor * instanceColor;\n"
+    "    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+static const char* VEHICLE_FS =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main() {\n"
+    "    gl_FragColor = texture2D(texture0, fragTexCoord) * colDiffuse * fragColor;\n"
+    "}\n";
+#endif
+
+bool VehicleRenderer::Load(const ModelManager* models, const VehicleLodConfig& lod) {
+    Unload();
+    lodConfig = lod;
+
+    // A shader that does not compile comes back as the default one
+    shader = LoadShaderFromMemory(VEHICLE_VS, VEHICLE_FS);
+    if (shader.id == rlGetShaderIdDefault()) {
+        std::cout << "[VehicleRenderer] Instancing shader unavailable, vehicles drawn one by one" << std::endl;
+        shader = Shader();
+        return false;
+    }
+    shader.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(shader, "mvp");
+    shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(shader, "instanceTransform");
+    instanceColorLoc = GetShaderLocationAttrib(shader, "instanceColor");
+
+    // Every box is this cube scaled by the type's boxBase
+    box = GenMeshCube(1.0f, 1.0f, 1.0f);
+    boxMaterial = LoadMaterialDefault();
+
+    for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+        TypeBatch& batch = batches[t];
+        const Model* model = models ? &models->GetModel((VehicleType)t) : nullptr;
+        if (!model || model->meshCount == 0) {
+            // Same box as the plain rendering without models (DrawCube 2 x 0.6 x 4)
+            batch.base = batch.boxBase = MatrixScale(2.0f, 0.6f, 4.0f);
+            for (int& triangles : batch.triangles) triangles = box.triangleCount;
+            continue;
+        }
+        batch.model = model;
+        batch.base = model->transform;
+
+        BoundingBox bounds = GetMeshBoundingBox(model->meshes[0]);
+        for (int m = 1; m < model->meshCount; m++) {
+            BoundingBox part = GetMeshBoundingBox(model->meshes[m]);
+            bounds.min = Vector3Min(bounds.min, part.min);
+            bounds.max = Vector3Max(bounds.max, part.max);
+        }
+        Vector3 size = Vector3Subtract(bounds.max, bounds.min);
+        Vector3 center = Vector3Scale(Vector3Add(bounds.min, bounds.max), 0.5f);
+        batch.boxBase = MatrixMultiply(MatrixMultiply(MatrixScale(size.x, size.y, size.z), MatrixTranslate(center.x, center.y, center.z)),
+                                       batch.base);
+
+        // Reduced level: one grid for the whole model, so its parts stay joined
+        float longest = fmaxf(size.x, fmaxf(size.y, size.z));
+        float cellSize = lodConfig.reducedCells > 0 ? longest / lodConfig.reducedCells : 0.0f;
+        for (int m = 0; m < model->meshCount; m++) {
+            batch.triangles[VEHICLE_LOD_FULL] += model->meshes[m].triangleCount;
+            Mesh simplified = SimplifyMesh(model->meshes[m], cellSize);
+            if (simplified.triangleCount == 0) continue;   // Details smaller than a cell vanish
+            UploadMesh(&simplified, false);
+            batch.reduced.push_back(simplified);
+            batch.reducedMaterial.push_back(model->meshMaterial[m]);
+            batch.triangles[VEHICLE_LOD_REDUCED] += simplified.triangleCount;
+        }
+        // Nothing left (or no grid): the reduced level draws the full model
+        if (batch.reduced.empty()) batch.triangles[VEHICLE_LOD_REDUCED] = batch.triangles[VEHICLE_LOD_FULL];
+        batch.triangles[VEHICLE_LOD_BOX] = box.triangleCount;
+    }
+    loaded = true;
+    return true;
+}
+
+void VehicleRenderer::Unload() {
+    if (!loaded) return;
+    for (TypeBatch& batch : batches) {
+        for (LodBatch& level : batch.levels) {
+            if (level.colorBuffer != 0) rlUnloadVertexBuffer(level.colorBuffer);
+        }
+        for (Mesh& mesh : batch.reduced) UnloadMesh(mesh);
+        batch = TypeBatch();
+    }
+    lodStates.clear();
+    UnloadMesh(box);
+    box = Mesh();
+    UnloadMaterial(boxMaterial);
+    boxMaterial = Material();
+    UnloadShader(shader);
+    shader = Shader();
+    instanceColorLoc = -1;
+    loaded = false;
+}
+
+void VehicleRenderer::Begin(const Frustum& view) {
+    eye = view.GetEye();
+    lodEnabled = view.IsEnabled();
+    for (TypeBatch& batch : batches) {
+        for (LodBatch& level : batch.levels) {
+            level.transforms.clear();
+            level.colors.clear();
+        }
+    }
+}
+
+void VehicleRenderer::DrawMeshes(LodBatch& level, const Mesh& mesh, const Material& material, bool tinted) {
+    int count = (int)level.transforms.size();
+    // The instance color is an attribute of the mesh's vertex array: DrawMeshInstanced keeps it
+    // and only adds the transforms
+    if (instanceColorLoc >= 0 && rlEnableVertexArray(mesh.vaoId)) {
+        if (tinted) {
+            rlEnableVertexBuffer(level.colorBuffer);
+            rlSetVertexAttribute(instanceColorLoc, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+            rlSetVertexAttributeDivisor(instanceColorLoc, 1);
+            rlEnableVertexAttribute(instanceColorLoc);
+        } else {
+            float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            rlDisableVertexAttribute(instanceColorLoc);
+            rlSetVertexAttributeDefault(instanceColorLoc, white, SHADER_ATTRIB_VEC4, 1);
+        }
+        rlDisableVertexBuffer();
+        rlDisableVertexArray();
+    }
+    Material instancing = material;
+    instancing.shader = shader;
+    DrawMeshInstanced(mesh, instancing, level.transforms.data(), count);
+    drawCalls++;
+}
+
+void VehicleRenderer::Flush() {
+    drawCalls = 0;
+    for (int& count : lodCounts) count = 0;
+    if (!loaded) return;
+    for (TypeBatch& batch : batches) {
+        for (int l = 0; l < VEHICLE_LOD_COUNT; l++) {
+            LodBatch& level = batch.levels[l];
+            int count = (int)level.colors.size();
+            if (count == 0) continue;
+            lodCounts[l] += count;
+
+            // Colors of this frame to the GPU (the buffer grows, never shrinks)
+            if (count > level.colorCapacity) {
+                if (level.colorBuffer != 0) rlUnloadVertexBuffer(level.colorBuffer);
+                level.colorCapacity = count * 2;
+                level.colorBuffer = rlLoadVertexBuffer(nullptr, level.colorCapacity * (int)sizeof(Color), true);
+            }
+            rlUpdateVertexBuffer(level.colorBuffer, level.colors.data(), count * (int)sizeof(Color), 0);
+
+            // The box takes the vehicle's color, like the plain rendering
+            if (!batch.model || l == VEHICLE_LOD_BOX) {
+                DrawMeshes(level, box, boxMaterial, true);
+                continue;
+            }
+            const Model& model = *batch.model;
+            if (l == VEHICLE_LOD_REDUCED && !batch.reduced.empty()) {
+                for (size_t m = 0; m < batch.reduced.size(); m++) {
+                    int material = batch.reducedMaterial[m];
+                    DrawMeshes(level, batch.reduced[m], model.materials[material], material == 0);
+                }
+                continue;
+            }
+            for (int m = 0; m < model.meshCount; m++) {
+                int material = model.meshMaterial[m];
+                DrawMeshes(level, model.meshes[m], model.materials[material], material == 0);
+            }
+        }
+    }
+}
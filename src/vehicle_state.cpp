@@ -0,0 +1,222 @@
+#include "vehicle_state.h"
+#include <utility>
+#include <algorithm>
+#include <cmath>
+
+VehicleState VehicleKinematics::GetRow(size_t i) const {
+    VehicleState s;
+    s.position = Position(i);
+    s.forward = Forward(i);
+    s.speed = speed[i];
+    s.desiredSpeed = desiredSpeed[i];
+    s.length = length[i];
+    s.targetNodeId = targetNodeId[i];
+    s.currentNodeId = currentNodeId[i];
+    s.forceMoveUntil = forceMoveUntil[i];
+    s.finished = finished[i] != 0;
+    s.routeSeed = routeSeed[i];
+    s.routeId = routeId[i];
+    s.edgeTime = edgeTime[i];
+    s.doneEdge = doneEdge[i];
+    s.doneTime = doneTime[i];
+    return s;
+}
+
+void VehicleKinematics::PushBack(const VehicleState& s) {
+    posX.push_back(s.position.x);
+    posY.push_back(s.position.y);
+    posZ.push_back(s.position.z);
+    fwdX.push_back(s.forward.x);
+    fwdZ.push_back(s.forward.z);
+    speed.push_back(s.speed);
+    desiredSpeed.push_back(s.desiredSpeed);
+    length.push_back(s.length);
+    targetNodeId.push_back(s.targetNodeId);
+    currentNodeId.push_back(s.currentNodeId);
+    forceMoveUntil.push_back(s.forceMoveUntil);
+    finished.push_back(s.finished ? 1 : 0);
+    routeSeed.push_back(s.routeSeed);
+    routeId.push_back(s.routeId);
+    edgeTime.push_back(s.edgeTime);
+    doneEdge.push_back(s.doneEdge);
+    doneTime.push_back(s.doneTime);
+    prevX.push_back(s.position.x);
+    prevY.push_back(s.position.y);
+    prevZ.push_back(s.position.z);
+    prevFwdX.push_back(s.forward.x);
+    prevFwdZ.push_back(s.forward.z);
+}
+
+void VehicleKinematics::MoveRow(size_t from, size_t to) {
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    posZ[to] = posZ[from];
+    fwdX[to] = fwdX[from];
+    fwdZ[to] = fwdZ[from];
+    speed[to] = speed[from];
+    desiredSpeed[to] = desiredSpeed[from];
+    length[to] = length[from];
+    targetNodeId[to] = targetNodeId[from];
+    currentNodeId[to] = currentNodeId[from];
+    forceMoveUntil[to] = forceMoveUntil[from];
+    finished[to] = finished[from];
+    routeSeed[to] = routeSeed[from];
+    routeId[to] = routeId[from];
+    edgeTime[to] = edgeTime[from];
+    doneEdge[to] = doneEdge[from];
+    doneTime[to] = doneTime[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    prevZ[to] = prevZ[from];
+    prevFwdX[to] = prevFwdX[from];
+    prevFwdZ[to] = prevFwdZ[from];
+}
+
+void VehicleKinematics::SwapRows(size_t a, size_t b) {
+    std::swap(posX[a], posX[b]);
+    std::swap(posY[a], posY[b]);
+    std::swap(posZ[a], posZ[b]);
+    std::swap(fwdX[a], fwdX[b]);
+    std::swap(fwdZ[a], fwdZ[b]);
+    std::swap(speed[a], speed[b]);
+    std::swap(desiredSpeed[a], desiredSpeed[b]);
+    std::swap(length[a], length[b]);
+    std::swap(targetNodeId[a], targetNodeId[b]);
+    std::swap(currentNodeId[a], currentNodeId[b]);
+    std::swap(forceMoveUntil[a], forceMoveUntil[b]);
+    std::swap(finished[a], finished[b]);
+    std::swap(routeSeed[a], routeSeed[b]);
+    std::swap(routeId[a], routeId[b]);
+    std::swap(edgeTime[a], edgeTime[b]);
+    std::swap(doneEdge[a], doneEdge[b]);
+    std::swap(doneTime[a], doneTime[b]);
+    std::swap(prevX[a], prevX[b]);
+    std::swap(prevY[a], prevY[b]);
+    std::swap(prevZ[a], prevZ[b]);
+    std::swap(prevFwdX[a], prevFwdX[b]);
+    std::swap(prevFwdZ[a], prevFwdZ[b]);
+}
+
+void VehicleKinematics::PopBack() {
+    posX.pop_back();
+    posY.pop_back();
+    posZ.pop_back();
+    fwdX.pop_back();
+    fwdZ.pop_back();
+    speed.pop_back();
+    desiredSpeed.pop_back();
+    length.pop_back();
+    targetNodeId.pop_back();
+    currentNodeId.pop_back();
+    forceMoveUntil.pop_back();
+    finished.pop_back();
+    routeSeed.pop_back();
+    routeId.pop_back();
+    edgeTime.pop_back();
+    doneEdge.pop_back();
+    doneTime.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    prevZ.pop_back();
+    prevFwdX.pop_back();
+    prevFwdZ.pop_back();
+}
+
+void VehicleKinematics::Reserve(size_t capacity) {
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    posZ.reserve(capacity);
+    fwdX.reserve(capacity);
+    fwdZ.reserve(capacity);
+    speed.reserve(capacity);
+    desiredSpeed.reserve(capacity);
+    length.reserve(capacity);
+    targetNodeId.reserve(capacity);
+    currentNodeId.reserve(capacity);
+    forceMoveUntil.reserve(capacity);
+    finished.reserve(capacity);
+    routeSeed.reserve(capacity);
+    routeId.reserve(capacity);
+    edgeTime.reserve(capacity);
+    doneEdge.reserve(capacity);
+    doneTime.reserve(capacity);
+    prevX.reserve(capacity);
+    prevY.reserve(capacity);
+    prevZ.reserve(capacity);
+    prevFwdX.reserve(capacity);
+    prevFwdZ.reserve(capacity);
+}
+
+void VehicleKinematics::Clear() {
+    posX.clear();
+    posY.clear();
+    posZ.clear();
+    fwdX.clear();
+    fwdZ.clear();
+    speed.clear();
+    desiredSpeed.clear();
+    length.clear();
+    targetNodeId.clear();
+    currentNodeId.clear();
+    forceMoveUntil.clear();
+    finished.clear();
+    routeSeed.clear();
+    routeId.clear();
+    edgeTime.clear();
+    doneEdge.clear();
+    doneTime.clear();
+    prevX.clear();
+    prevY.clear();
+    prevZ.clear();
+    prevFwdX.clear();
+    prevFwdZ.clear();
+}
+
+void VehicleKinematics::SavePreviousPose() {
+    prevX = posX;
+    prevY = posY;
+    prevZ = posZ;
+    prevFwdX = fwdX;
+    prevFwdZ = fwdZ;
+}
+
+void VehicleKinematics::SavePreviousPose(size_t begin, size_t end) {
+    std::copy(posX.begin() + begin, posX.begin() + end, prevX.begin() + begin);
+    std::copy(posY.begin() + begin, posY.begin() + end, prevY.begin() + begin);
+    std::copy(posZ.begin() + begin, posZ.begin() + end, prevZ.begin() + begin);
+    std::copy(fwdX.begin() + begin, fwdX.begin() + end, prevFwdX.begin() + begin);
+    std::copy(fwdZ.begin() + begin, fwdZ.begin() + end, prevFwdZ.begin() + begin);
+}
+
+Vector3 VehicleKinematics::InterpolatedPosition(size_t i, float alpha) const {
+    return { prevX[i] + (posX[i] - prevX[i]) * alpha,
+             prevY[i] + (posY[i] - prevY[i]) * alpha,
+             prevZ[i] + (posZ[i] - prevZ[i]) * alpha };
+}
+
+Vector3 VehicleKinematics::InterpolatedForward(size_t i, float alpha) const {
+    float x = prevFwdX[i] + (fwdX[i] - prevFwdX[i]) * alpha;
+    float z = prevFwdZ[i] + (fwdZ[i] - prevFwdZ[i]) * alpha;
+    float len = sqrtf(x*x + z*z);
+    if (len <= 0.0f) return Forward(i);
+    return { x / len, 0.0f, z / len };
+}
+
+void VehicleKinematics::SnapPreviousPose(size_t i) {
+    prevX[i] = posX[i];
+    prevY[i] = posY[i];
+    prevZ[i] = posZ[i];
+    prevFwdX[i] = fwdX[i];
+    prevFwdZ[i] = fwdZ[i];
+}
+
+size_t VehicleKinematics::BytesPerVehicle() {
+    return 8 * sizeof(float)      // position, heading, speeds, length
+         + 2 * sizeof(int)        // node IDs
+         + sizeof(double)         // forceMoveUntil
+         + sizeof(unsigned char)  // finished
+         + sizeof(uint32_t)       // routeSeed
+         + sizeof(int)            // route
+         + 2 * sizeof(float) + sizeof(int)   // edge time, last edge driven and its time
+         + 5 * sizeof(float);     // previous pose
+}
@@ -0,0 +1,11 @@
+#include "vehicle_types.h"
+
+bool FindVehicleType(const std::string& name, VehicleType& type) {
+    for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+        if (name == VEHICLE_TYPE_INFO[t].name) {
+            type = (VehicleType)t;
+            return true;
+        }
+    }
+    return false;
+}
@@ -2,9 +2,32 @@
 #include <cassert>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
 #include "roadgraph.h"
 #include "traffic_manager.h"
 #include "vehicle.h"
+#include "spatial_grid.h"
+#include "event_scheduler.h"
+#include "occupancy_index.h"
+#include "spawner.h"
+#include "vehicle_pool.h"
+#include "vehicle_traits.h"
+#include "simulation_core.h"
+#include "scenario.h"
+#include "sim_pacer.h"
+#include "job_system.h"
+#include "kinematics_kernel.h"
+#include "sim_random.h"
+#include "route_planner.h"
+#include "contraction_hierarchy.h"
+#include "travel_times.h"
+#include "route_refresher.h"
+#include "frustum.h"
+#include "vehicle_lod.h"
+#include <sstream>
+#include <stdexcept>
 #include "raylib.h"
 
 // Simple test helper
@@ -36,12 +59,18 @@ TEST_CASE(TestRoadGraphConnections) {
 
 // --- TEST 3: Vehicle Initialization ---
 TEST_CASE(TestVehicleInitialization) {
-    Vector3 startPos = {0, 0, 0};
-    Car myCar(startPos, 1);
+    VehicleState state;
+    state.position = {0, 0, 0};
+    state.targetNodeId = 1;
+
+    VehiclePool vehicles;
+    vehicles.Create<Car>(state);
+    VehicleState myCar = vehicles.GetKinematics().GetRow(0);
     
     assert(myCar.position.x == 0);
     assert(myCar.targetNodeId == 1);
     assert(myCar.speed > 0); // Should have a default config speed
+    assert(myCar.length == GetVehicleTypeInfo(VEHICLE_CAR).length);
 }
 
 // --- TEST 4: Spawner Functionality ---
@@ -56,7 +85,7 @@ TEST_CASE(TestVehicleSpawner) {
     // Attempt to spawn a vehicle at Node 1
     // Assuming your Spawner class has a SpawnSpecific method
     // If not, this test verifies the logic of adding to the vector
-    vehicles.push_back(std::make_unique<Taxi>((Vector3){0,0,0}, 2));
+    vehicles.push_back(std::make_unique<Taxi>());
     
     assert(vehicles.size() == 1);
     assert(vehicles[0]->color.r == YELLOW.r); // Verify it's a Taxi
@@ -68,25 +97,1121 @@ TEST_CASE(TestTeleportationLogic) {
     graph.AddNode(1, {0,0,0}, TELEPORT);
     graph.AddNode(2, {100,0,100}, START);
     graph.SetTeleportTarget(1, 2);
+    graph.AddNode(3, {110,0,100}, DECISION);
     graph.ConnectNodes(2, 3); // Path after teleport
+    graph.Finalize();
 
-    std::vector<std::unique_ptr<Vehicle>> vehicles;
-    vehicles.push_back(std::make_unique<Car>((Vector3){0,0,0}, 1));
+    VehicleState state;
+    state.targetNodeId = 1;
+    VehiclePool vehicles;
+    vehicles.Create<Car>(state);
+    VehicleKinematics& k = vehicles.GetKinematics();
     
+    OccupancyIndex occupancy;
+    occupancy.Watch(graph);
+    occupancy.Update(vehicles);
+
     // Simulate arrival at node 1 (TELEPORT)
     // The vehicle update logic should move it to node 2
-    vehicles[0]->update(0.1f, graph, vehicles);
+    Vehicle::Move(k, 0, 0.1f, graph, occupancy);
 
     // Position should now be at the teleport destination
-    assert(vehicles[0]->position.x == 100);
-    assert(vehicles[0]->position.z == 100);
+    assert(k.posX[0] == 100);
+    assert(k.posZ[0] == 100);
+    assert(k.targetNodeId[0] == 3);
+}
+
+// --- TEST 6: Spatial Grid Neighbour Query ---
+TEST_CASE(TestSpatialGridQuery) {
+    std::vector<Vector3> points = { {0,0,0}, {5,0,0}, {200,0,200}, {-3,0,4} };
+    SpatialGrid grid(10.0f);
+    grid.Build(points);
+
+    std::vector<int> found;
+    grid.ForEachNear({0,0,0}, 8.0f, [&](int idx) { found.push_back(idx); });
+
+    // The far point must not be visited, the close ones must all be
+    assert(std::find(found.begin(), found.end(), 2) == found.end());
+    assert(std::find(found.begin(), found.end(), 0) != found.end());
+    assert(std::find(found.begin(), found.end(), 1) != found.end());
+    assert(std::find(found.begin(), found.end(), 3) != found.end());
+}
+
+// --- TEST 7: Finalized Graph (CSR) ---
+TEST_CASE(TestRoadGraphFinalize) {
+    RoadGraph graph;
+    graph.AddNode(10, {0,0,0}, START);
+    graph.AddNode(4, {10,0,0}, DECISION);
+    graph.AddNode(7, {10,0,10}, ARC);
+    graph.ConnectNodes(10, 4);
+    graph.ConnectNodes(4, 7);
+    graph.ConnectNodes(4, 10);
+    graph.Finalize();
+
+    int a = graph.IndexOf(10), b = graph.IndexOf(4), c = graph.IndexOf(7);
+    assert(graph.IsFinalized() && graph.GetNodeCount() == 3 && graph.GetEdgeCount() == 3);
+    assert(graph.IdOf(b) == 4 && graph.TypeOf(c) == ARC && graph.PositionOf(c).z == 10);
+    assert(graph.Successors(a).size() == 1 && graph.Successors(a)[0] == b);
+    assert(graph.Successors(b).size() == 2 && graph.Successors(c).empty());
+    assert(graph.FindEdge(b, a) >= 0 && graph.FindEdge(a, c) == -1);
+
+    // Unknown IDs are reported, not mapped to another node
+    bool thrown = false;
+    try { graph.GetNode(5); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    // A change drops the CSR form: no dense index is handed out until the next Finalize
+    // (the builder side still works), and the new node is there after it
+    graph.AddNode(12, {0,0,10}, DECISION);
+    assert(!graph.IsFinalized() && graph.GetNodeCount() == 0 && graph.GetEdgeCount() == 0);
+    thrown = false;
+    try { graph.IndexOf(10); } catch (const std::logic_error&) { thrown = true; }
+    assert(thrown && graph.GetNode(12).pos.z == 10);
+    graph.Finalize();
+    assert(graph.GetNodeCount() == 4 && graph.PositionOf(graph.IndexOf(12)).z == 10);
+
+    thrown = false;
+    graph.ConnectNodes(7, 99);
+    try { graph.Finalize(); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown && !graph.IsFinalized() && graph.GetNodeCount() == 0);
+}
+
+// --- TEST 8: Event Scheduler ---
+TEST_CASE(TestEventScheduler) {
+    EventScheduler clock;
+    std::vector<int> fired;
+
+    clock.Schedule(2.0, [&]() { fired.push_back(2); });
+    clock.Schedule(1.0, [&]() { fired.push_back(1); });
+    EventId dropped = clock.Schedule(1.5, [&]() { fired.push_back(99); });
+    clock.Cancel(dropped);
+
+    // A periodic event re-schedules itself from its own fire time
+    std::function<void()> tick = [&]() {
+        fired.push_back(10);
+        if (clock.Now() < 2.9) clock.Schedule(1.0, tick);
+    };
+    clock.Schedule(0.9, tick);
+
+    clock.Advance(0.5);
+    assert(fired.empty());
+
+    clock.Advance(2.5); // Now = 3.0: ticks at 0.9, 1.9, 2.9 interleaved with 1 and 2
+    std::vector<int> expected = { 10, 1, 10, 2, 10 };
+    assert(fired == expected);
+    assert(clock.Now() == 3.0);
+}
+
+// --- TEST 9: Entry Point Occupancy ---
+TEST_CASE(TestOccupancyIndex) {
+    RoadGraph graph;
+    graph.AddNode(1, {0,0,0}, START);
+    graph.AddNode(2, {50,0,0}, DECISION);
+    graph.ConnectNodes(1, 2);
+    graph.Finalize();
+
+    OccupancyIndex occupancy(8.0f);
+    occupancy.Watch(graph);
+    assert(occupancy.GetZoneCount() == 1);
+
+    VehicleState state;
+    state.position = {20,0,0};
+    state.targetNodeId = 2;
+    VehiclePool vehicles;
+    vehicles.Create<Car>(state);
+    VehicleKinematics& k = vehicles.GetKinematics();
+    occupancy.Update(vehicles);
+    assert(occupancy.IsClear(graph.IndexOf(1)));
+    assert(occupancy.IsClear(graph.IndexOf(2))); // Not an entry point
+
+    k.SetPosition(0, {5,0,0});
+    occupancy.Update(vehicles);
+    assert(!occupancy.IsClear(graph.IndexOf(1)));
+
+    // A new arrival blocks the zone right away, without waiting for the next Update
+    k.SetPosition(0, {20,0,0});
+    occupancy.Update(vehicles);
+    occupancy.MarkArrival(graph.IndexOf(1));
+    assert(!occupancy.IsClear(graph.IndexOf(1)));
+}
+
+// --- TEST 10: Per-Start-Node Spawn Queues ---
+TEST_CASE(TestSpawnerQueues) {
+    RoadGraph graph;
+    graph.AddNode(1, {0,0,0}, START);
+    graph.AddNode(2, {50,0,0}, DECISION);
+    graph.ConnectNodes(1, 2);
+    graph.Finalize();
+
+    SimulationConfig savedConfig = globalConfig;
+    globalConfig.vehicleConfigs = { { VEHICLE_CAR, 3, { 1 } } };
+
+    VehicleSpawner spawner;
+    spawner.LoadFromConfig();
+    assert(spawner.GetQueuedCount() == 3);
+
+    OccupancyIndex occupancy;
+    occupancy.Watch(graph);
+    EventScheduler clock;
+    VehiclePool vehicles;
+
+    // Only the head spawns: the start node is busy right after
+    occupancy.Update(vehicles);
+    spawner.Update(graph, vehicles, occupancy, clock);
+    assert(vehicles.Count() == 1 && spawner.GetQueuedCount() == 2);
+    VehicleKinematics& k = vehicles.GetKinematics();
+    assert(k.currentNodeId[0] == 1 && k.targetNodeId[0] == 2);
+    assert(k.fwdX[0] == 1.0f); // Facing the first edge
+
+    occupancy.Update(vehicles);
+    spawner.Update(graph, vehicles, occupancy, clock);
+    assert(vehicles.Count() == 1);
+
+    // Once the node is clear, the next one spawns after the retry delay
+    k.SetPosition(0, {40,0,0});
+    clock.Advance(1.0);
+    occupancy.Update(vehicles);
+    spawner.Update(graph, vehicles, occupancy, clock);
+    assert(vehicles.Count() == 2 && spawner.GetQueuedCount() == 1);
+
+    // A blocked start node only delays its own queue
+    graph.AddNode(3, {0,0,100}, START);
+    graph.ConnectNodes(3, 2);
+    graph.Finalize();
+    globalConfig.vehicleConfigs = { { VEHICLE_CAR, 2, { 1 } }, { VEHICLE_CAR, 3, { 3 } } };
+    spawner.LoadFromConfig();
+    occupancy.Watch(graph);
+    vehicles.Clear();
+    auto clearNode3 = [&]() {
+        for (int i = 0; i < (int)k.Size(); i++) {
+            if (k.currentNodeId[i] == 3) k.SetPosition(i, {25,0,50});
+        }
+        occupancy.Update(vehicles);
+    };
+    occupancy.Update(vehicles);
+    spawner.Update(graph, vehicles, occupancy, clock);
+    assert(vehicles.Count() == 2 && spawner.GetQueuedCount() == 3);
+    clearNode3();
+    spawner.Update(graph, vehicles, occupancy, clock);   // Node 1 blocked, node 3 spawns
+    assert(vehicles.Count() == 3 && spawner.GetQueuedCount() == 2);
+    clearNode3();
+    spawner.Update(graph, vehicles, occupancy, clock);   // Same time: node 3 does not wait for node 1
+    assert(vehicles.Count() == 4 && spawner.GetQueuedCount() == 1);
+
+    globalConfig = savedConfig;
+}
+
+// --- TEST 11: Vehicle Pool & Handles ---
+TEST_CASE(TestVehiclePool) {
+    VehiclePool pool;
+    pool.Reserve(4);
+    int capacity = pool.GetCapacity();
+
+    VehicleKinematics& k = pool.GetKinematics();
+    VehicleState state;
+    state.targetNodeId = 1;
+
+    state.position = {1,0,0};
+    VehicleHandle a = pool.Create<Car>(state);
+    state.position = {2,0,0};
+    VehicleHandle b = pool.Create<Motorcycle>(state);
+    state.position = {3,0,0};
+    VehicleHandle c = pool.Create<Bus>(state);
+    assert(pool.Count() == 3 && k.Size() == 3 && k.posX[pool.IndexOf(b)] == 2);
+
+    // Removal fills the hole from further down (object and kinematics row), handles still resolve
+    k.finished[pool.IndexOf(a)] = 1;
+    assert(pool.RemoveFinished() == 1);
+    assert(pool.Count() == 2 && k.Size() == 2 && pool.Get(a) == nullptr);
+    assert(pool[0] == pool.Get(c) && pool.HandleAt(0) == c);
+    assert(k.posX[0] == 3 && k.length[0] == GetVehicleTypeInfo(VEHICLE_BUS).length);
+    assert(k.posX[pool.IndexOf(b)] == 2);
+
+    // The freed slot is recycled under a new generation: the old handle stays stale
+    state.position = {4,0,0};
+    VehicleHandle d = pool.Create<Taxi>(state);
+    assert(d.slot == a.slot && d != a);
+    assert(pool.Get(a) == nullptr && pool.IndexOf(a) == -1 && k.posX[pool.IndexOf(d)] == 4);
+
+    pool.Destroy(b);
+    assert(pool.Count() == 2 && pool.Get(b) == nullptr);
+    assert(pool.GetCapacity() == capacity); // No growth while churning
+}
+
+// --- TEST 12: Vehicles grouped by type (static per-type behaviour) ---
+TEST_CASE(TestVehicleTypeGroups) {
+    VehiclePool pool;
+    VehicleState state;
+    state.targetNodeId = 1;
+
+    // Interleaved creation: rows still end up packed by type
+    std::vector<VehicleHandle> handles;
+    for (int n = 0; n < 30; n++) {
+        state.position = {(float)n, 0, 0};
+        switch (n % 4) {
+            case 0: handles.push_back(pool.Create<Motorcycle>(state)); break;
+            case 1: handles.push_back(pool.Create<Car>(state)); break;
+            case 2: handles.push_back(pool.Create<Taxi>(state)); break;
+            default: handles.push_back(pool.Create<Bus>(state)); break;
+        }
+    }
+    auto checkGroups = [&]() {
+        assert(pool.GroupBegin(VEHICLE_CAR) == 0 && pool.GroupEnd(VEHICLE_MOTORCYCLE) == pool.Count());
+        ForEachVehicleType([&](auto tag) {
+            typedef typename decltype(tag)::type T;
+            for (size_t i = pool.GroupBegin(VehicleTraits<T>::TYPE); i < pool.GroupEnd(VehicleTraits<T>::TYPE); i++) {
+                assert(pool[i]->type == VehicleTraits<T>::TYPE);
+                assert(pool.GetKinematics().length[i] == VehicleTraits<T>::Info().length);
+            }
+        });
+        for (size_t n = 0; n < handles.size(); n++) {
+            int row = pool.IndexOf(handles[n]);
+            if (row >= 0) assert(pool.GetKinematics().posX[row] == (float)n); // Row follows its vehicle
+        }
+    };
+    assert(pool.CountOf(VEHICLE_CAR) == 8 && pool.CountOf(VEHICLE_MOTORCYCLE) == 8);
+    checkGroups();
+
+    // Removal from the middle of the groups
+    for (size_t n = 0; n < handles.size(); n += 3) pool.Destroy(handles[n]);
+    assert(pool.Count() == 20);
+    checkGroups();
+
+    // Per-type behaviour: only the motorcycles are animated, and lean into a turn
+    size_t first, last;
+    Vehicle::AnimatedRows(pool, first, last);
+    assert(first == pool.GroupBegin(VEHICLE_MOTORCYCLE) && last == pool.GroupEnd(VEHICLE_MOTORCYCLE));
+    VehicleKinematics& k = pool.GetKinematics();
+    for (size_t i = 0; i < k.Size(); i++) { k.fwdX[i] = 0.0f; k.fwdZ[i] = 1.0f; }
+    Vehicle::AnimateRange(pool, first, last, 0.5f);
+    size_t moto = pool.GroupBegin(VEHICLE_MOTORCYCLE);
+    assert(pool.As<Motorcycle>(moto).tiltAngle == VehicleTraits<Motorcycle>::MAX_TILT); // Spawned facing +X, now +Z: sharp turn
+    Vehicle::AnimateRange(pool, 0, pool.Count(), 0.5f);
+    assert(pool.As<Motorcycle>(moto).tiltAngle == 0.0f); // Straight again
+}
+
+// --- TEST 13: Vehicle Type Registry ---
+TEST_CASE(TestVehicleTypeRegistry) {
+    // Names round-trip, unknown names are rejected
+    for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+        VehicleType found;
+        assert(FindVehicleType(GetVehicleTypeName((VehicleType)t), found) && found == t);
+    }
+    VehicleType found = VEHICLE_BUS;
+    assert(!FindVehicleType("Tram", found) && found == VEHICLE_BUS);
+
+    // Run-time type -> the right class, row values from the registry
+    VehiclePool pool;
+    VehicleState state;
+    state.targetNodeId = 1;
+    VehicleHandle police = pool.Create(VEHICLE_POLICE, state);
+    VehicleHandle moto = pool.Create(VEHICLE_MOTORCYCLE, state);
+    assert(pool.Get(police)->type == VEHICLE_POLICE && pool.CountOf(VEHICLE_POLICE) == 1);
+    assert(pool.GetKinematics().desiredSpeed[pool.IndexOf(moto)] == GetVehicleTypeInfo(VEHICLE_MOTORCYCLE).speed);
+    assert(pool.Get(police)->color.b == GetVehicleTypeInfo(VEHICLE_POLICE).color.b);
+
+    // Per-type statistics add up to the totals
+    SimulationConfig savedConfig = globalConfig;
+    globalConfig = GetDefaultConfig();
+    SimulationCore sim;
+    sim.Init();
+    sim.ApplyConfiguration();
+    for (int t = 0; t < 600; t++) sim.Step(1.0f / 60.0f);
+    const SimulationStats& stats = sim.GetStats();
+    int spawned = 0;
+    long long updates = 0;
+    double speedSum = 0.0;
+    for (const VehicleTypeStats& ts : stats.byType) {
+        spawned += ts.spawned;
+        updates += ts.updates;
+        speedSum += ts.speedSum;
+    }
+    assert(spawned == stats.spawned && updates == stats.vehicleUpdates);
+    assert(fabs(speedSum - stats.speedSum) < 1e-6 * stats.speedSum);
+    assert(stats.byType[VEHICLE_CAR].spawned > 0);
+    globalConfig = savedConfig;
+}
+
+// --- TEST 14: Scenario Files ---
+TEST_CASE(TestScenarioParsing) {
+    SimulationConfig base = GetDefaultConfig();
+    std::istringstream text(
+        "# comment line\n"
+        "seed 7\n"
+        "vehicle Bus 4 0 1   # trailing comment\n"
+        "vehicle Car 2 26\n");
+
+    SimulationConfig cfg = ParseScenario(text, base);
+    assert(cfg.seed == 7);
+    assert(cfg.maxVehicles == base.maxVehicles); // Not given: kept
+    assert(cfg.vehicleConfigs.size() == 2);      // Replaces the default groups
+    assert(cfg.vehicleConfigs[0].type == VEHICLE_BUS && cfg.vehicleConfigs[0].count == 4);
+    assert(cfg.vehicleConfigs[0].startNodes.size() == 2 && cfg.vehicleConfigs[1].startNodes[0] == 26);
+
+    bool threw = false;
+    std::istringstream bad("seed 1\nvehicle Car two 0\n");
+    try { ParseScenario(bad, base); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    threw = false;
+    std::istringstream unknown("vehicle Tram 2 0\n");
+    try { ParseScenario(unknown, base); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+// --- TEST 15: Headless Simulation Core ---
+TEST_CASE(TestHeadlessSimulation) {
+    SimulationConfig savedConfig = globalConfig;
+    globalConfig = GetDefaultConfig();
+
+    // Runs without any window: the clock is the explicit dt
+    SimulationCore sim;
+    sim.Init();
+    sim.ApplyConfiguration();
+    int demand = sim.GetQueuedCount();
+    for (int t = 0; t < 600; t++) sim.Step(1.0f / 60.0f);
+
+    const SimulationStats& stats = sim.GetStats();
+    assert(stats.ticks == 600);
+    assert(stats.simTime > 9.99 && stats.simTime < 10.01);
+    assert(stats.spawned > 0 && stats.spawned == demand - sim.GetQueuedCount());
+    assert(sim.GetVehicleCount() == stats.spawned - stats.completed);
+    assert(stats.AverageSpeed() > 0.0);
+
+    // Same seed, same run
+    SimulationCore again;
+    again.Init();
+    again.ApplyConfiguration();
+    for (int t = 0; t < 600; t++) again.Step(1.0f / 60.0f);
+    assert(again.GetStats().speedSum == stats.speedSum);
+
+    globalConfig = savedConfig;
+}
+
+// --- TEST 16: Fixed Timestep & Render Interpolation ---
+TEST_CASE(TestFixedTimestep) {
+    SimulationConfig savedConfig = globalConfig;
+    globalConfig = GetDefaultConfig();
+    globalConfig.tickRate = 50.0f;
+
+    SimulationCore sim;
+    sim.Init();
+    sim.ApplyConfiguration();
+    assert(sim.GetTickDt() == 1.0f / 50.0f);
+
+    // Frame times do not line up with ticks: the remainder is carried over
+    assert(sim.Advance(0.03f) == 1);
+    assert(fabs(sim.GetInterpolationAlpha() - 0.5f) < 1e-3f);
+    assert(sim.Advance(0.01f) == 1);
+    assert(sim.Advance(0.005f) == 0);
+    assert(sim.GetStats().ticks == 2);
+
+    // Interpolated pose between the last two ticks
+    VehicleState state;
+    state.targetNodeId = 1;
+    VehiclePool pool;
+    pool.Create<Car>(state);
+    VehicleKinematics& k = pool.GetKinematics();
+    k.SavePreviousPose();
+    k.SetPosition(0, {10,0,0});
+    k.SetForward(0, {0,0,1});
+    assert(k.InterpolatedPosition(0, 0.5f).x == 5.0f);
+    Vector3 f = k.InterpolatedForward(0, 0.5f);
+    assert(fabs(f.x - f.z) < 1e-5f && fabs(f.x * f.x + f.z * f.z - 1.0f) < 1e-5f);
+    k.SnapPreviousPose(0); // Teleport: no sliding across the map
+    assert(k.InterpolatedPosition(0, 0.0f).x == 10.0f);
+
+    globalConfig = savedConfig;
+}
+
+// --- TEST 17: Turbo (bounded ticks per frame, no overshoot) ---
+TEST_CASE(TestTurboPacing) {
+    // A step longer than the distance to the target lands on it instead of passing it
+    RoadGraph graph;
+    graph.AddNode(1, {0,0,0}, START);
+    graph.AddNode(2, {10,0,0}, DECISION);
+    graph.AddNode(3, {20,0,0}, DECISION);
+    graph.ConnectNodes(1, 2);
+    graph.ConnectNodes(2, 3);
+    graph.Finalize();
+
+    VehicleState state;
+    state.forward = {1,0,0};
+    state.targetNodeId = 2;
+    VehiclePool vehicles;
+    vehicles.Create<Car>(state);
+    VehicleKinematics& k = vehicles.GetKinematics();
+    OccupancyIndex occupancy;
+    Vehicle::Move(k, 0, 1.0f, graph, occupancy); // 15 m step, 10 m to go
+    assert(k.posX[0] == 10.0f);
+    assert(k.targetNodeId[0] == 3);
+
+    // The pacer never runs more ticks than its budget and drops what it cannot catch up
+    SimulationConfig savedConfig = globalConfig;
+    globalConfig = GetDefaultConfig();
+    SimulationCore sim;
+    sim.Init();
+    sim.ApplyConfiguration();
+
+    SimPacer pacer;
+    for (int frame = 0; frame < 5; frame++) {
+        int budget = pacer.GetTickBudget();
+        long long before = sim.GetStats().ticks;
+        pacer.RunFrame(sim, 1.0f / 60.0f, 1000.0f);
+        assert(sim.GetStats().ticks - before <= budget);
+        assert(sim.GetBacklog() <= budget * sim.GetTickDt() + 1e-4f);
+        assert(sim.GetInterpolationAlpha() <= 1.0f);
+    }
+
+    // Behind frames are skipped, but never more than MAX_SKIPPED_FRAMES in a row
+    // (a speed no budget can follow: always behind)
+    int skippedInARow = 0;
+    for (int frame = 0; frame < 40; frame++) {
+        if (pacer.RunFrame(sim, 0.25f, 1.0e6f)) skippedInARow = 0;
+        else skippedInARow++;
+        assert(skippedInARow <= SimPacer::MAX_SKIPPED_FRAMES);
+    }
+    assert(pacer.IsBehind());
+    assert(pacer.GetAchievedRate() > 0.0);
+
+    // At 1x the sim keeps up: every frame is rendered
+    pacer.Reset();
+    sim.DropBacklog(0);
+    for (int frame = 0; frame < 10; frame++) {
+        assert(pacer.RunFrame(sim, 1.0f / 60.0f, 1.0f));
+    }
+
+    // Turbo levels
+    assert(NextTurboLevel(0, 1) == 10);
+    assert(NextTurboLevel(10, -1) == 0);
+    assert(NextTurboLevel(1000, 1) == 1000);
+    assert(NextTurboLevel(0, -1) == 0);
+    globalConfig.turboMultiplier = 100;
+    assert(globalConfig.GetEffectiveSpeed() == 100.0f);
+
+    globalConfig = savedConfig;
+}
+
+// --- TEST 18: Parallel vehicle update (same result for any thread count) ---
+static std::vector<float> RunDenseRoad(JobSystem* workers) {
+    // One long road, many more vehicles than VEHICLE_BATCH so the update is really split
+    RoadGraph graph;
+    for (int n = 0; n < 20; n++) graph.AddNode(n, {n * 50.0f, 0, 0}, DECISION);
+    for (int n = 0; n + 1 < 20; n++) graph.ConnectNodes(n, n + 1);
+    graph.Finalize();
+
+    VehiclePool vehicles;
+    SimRandom rng(7);
+    for (int v = 0; v < 600; v++) {
+        VehicleState state;
+        state.position = {(float)rng.Range(0, 940) + 0.5f, 0, 0};
+        state.currentNodeId = (int)(state.position.x / 50.0f);
+        state.targetNodeId = state.currentNodeId + 1;
+        vehicles.Create<Car>(state);
+        vehicles.GetKinematics().speed[v] = (float)rng.Range(0, 15);
+    }
+
+    TrafficManager traffic;
+    OccupancyIndex occupancy;
+    occupancy.Watch(graph);
+    VehicleKinematics& k = vehicles.GetKinematics();
+    for (int tick = 0; tick < 30; tick++) {
+        traffic.UpdateVehicles(vehicles, graph, 1.0f / 60.0f, workers);
+        for (size_t i = 0; i < k.Size(); i++) Vehicle::Move(k, i, 1.0f / 60.0f, graph, occupancy);
+    }
+
+    std::vector<float> result(k.speed);
+    result.insert(result.end(), k.posX.begin(), k.posX.end());
+    return result;
+}
+
+TEST_CASE(TestParallelUpdate) {
+    // Chunks cover every index exactly once
+    JobSystem pool(4);
+    assert(pool.GetThreadCount() == 4);
+    std::vector<int> hits(1000, 0);
+    pool.ParallelFor(hits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) hits[i]++;
+    });
+    assert(std::count(hits.begin(), hits.end(), 1) == 1000);
+
+    // Double-buffered update: bit-identical whatever the thread count
+    std::vector<float> serial = RunDenseRoad(nullptr);
+    JobSystem one(1), three(3);
+    assert(RunDenseRoad(&one) == serial);
+    assert(RunDenseRoad(&three) == serial);
+    assert(RunDenseRoad(&pool) == serial);
+
+    // Whole simulation
+    SimulationConfig savedConfig = globalConfig;
+    globalConfig = GetDefaultConfig();
+    double speedSum[2];
+    int threadCounts[2] = {1, 4};
+    for (int run = 0; run < 2; run++) {
+        globalConfig.threadCount = threadCounts[run];
+        SimulationCore sim;
+        sim.Init();
+        sim.ApplyConfiguration();
+        assert(sim.GetThreadCount() == threadCounts[run]);
+        for (int t = 0; t < 600; t++) sim.Step(1.0f / 60.0f);
+        speedSum[run] = sim.GetStats().speedSum;
+    }
+    assert(speedSum[0] == speedSum[1]);
+    globalConfig = savedConfig;
+}
+
+// --- TEST 19: Job system (dependencies, chunks, timing) ---
+TEST_CASE(TestJobSystem) {
+    JobSystem jobs(4);
+    std::vector<int> order;
+    std::vector<int> chunkSum(100, 0);
+    std::atomic<int> stamp(0);
+    int stampA = -1, stampB = -1, stampC = -1;
+
+    // A -> (chunks, B) -> C
+    TaskId a = jobs.AddTask("a", [&]() { stampA = stamp++; });
+    TaskId chunks = jobs.AddParallelTask("chunks", []() { return (size_t)100; }, 7, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) chunkSum[i] += (int)i;
+    });
+    TaskId b = jobs.AddTask("b", [&]() { stampB = stamp++; });
+    TaskId c = jobs.AddTask("c", [&]() {
+        stampC = stamp++;
+        for (int i = 0; i < 100; i++) assert(chunkSum[i] == i); // All chunks done before
+    });
+    jobs.AddDependency(a, chunks);
+    jobs.AddDependency(a, b);
+    jobs.AddDependency(chunks, c);
+    jobs.AddDependency(b, c);
+
+    jobs.SetProfiling(true);
+    for (int run = 0; run < 3; run++) {
+        std::fill(chunkSum.begin(), chunkSum.end(), 0);
+        jobs.Run();
+        assert(stampA < stampB && stampB < stampC);
+    }
+
+    // Timing: one line per task, 15 chunks of 7 items per run
+    assert(jobs.GetProfile().size() == 4);
+    for (const TaskProfile& p : jobs.GetProfile()) {
+        assert(p.runs == 3);
+        if (p.name == "chunks") assert(p.chunks == 45);
+    }
+    assert(jobs.GetThreadBusyTime().size() == 4);
+    assert(jobs.GetRunTime() > 0.0);
+
+    // Parallel task with nothing to do this run still releases its successors
+    JobSystem single(1);
+    bool after = false;
+    TaskId empty = single.AddParallelTask("empty", []() { return (size_t)0; }, 8, [](size_t, size_t) { assert(false); });
+    TaskId next = single.AddTask("next", [&]() { after = true; });
+    single.AddDependency(empty, next);
+    single.Run();
+    assert(after);
+}
+
+// --- TEST 20: SIMD kinematics kernel matches the scalar path ---
+TEST_CASE(TestKinematicsKernel) {
+    const size_t n = 203; // Not a multiple of 8: the tail goes through the narrower paths
+    SimRandom rng(99);
+    std::vector<float> speed(n), desired(n), gap(n), leader(n);
+    std::vector<int32_t> mode(n);
+    for (size_t i = 0; i < n; i++) {
+        speed[i] = rng.Range(0, 2500) / 100.0f;
+        desired[i] = rng.Range(800, 2200) / 100.0f;
+        gap[i] = (rng.Range(0, 3) == 0) ? NO_LEADER_GAP : rng.Range(-200, 6000) / 100.0f;
+        leader[i] = rng.Range(0, 2000) / 100.0f;
+        mode[i] = rng.Range(0, 3);
+    }
+    SpeedControlInput in = { speed.data(), desired.data(), gap.data(), leader.data(), mode.data() };
+    SpeedControlParams params = { 4.0f, 20.0f, 18.0f, 1.0f / 60.0f };
+
+    std::vector<float> reference(n);
+    SpeedControlScalar(in, reference.data(), n, params);
+    assert(reference[0] >= 0.0f);
+
+    // Steering input: vehicles around targets, some inside the arrival threshold
+    std::vector<float> posX(n), posY(n, 0.0f), posZ(n), fwdX(n), fwdZ(n), tx(n), ty(n, 0.0f), tz(n);
+    std::vector<int32_t> active(n);
+    for (size_t i = 0; i < n; i++) {
+        posX[i] = rng.Range(-1000, 1000) / 10.0f;
+        posZ[i] = rng.Range(-1000, 1000) / 10.0f;
+        tx[i] = posX[i] + rng.Range(-300, 300) / 10.0f;
+        tz[i] = posZ[i] + rng.Range(-300, 300) / 10.0f;
+        float angle = rng.Range(0, 628) / 100.0f;
+        fwdX[i] = cosf(angle);
+        fwdZ[i] = sinf(angle);
+        active[i] = rng.Range(0, 9) != 0;
+    }
+    auto steer = [&](bool batch, std::vector<float>* out, std::vector<unsigned char>& arrived) {
+        std::vector<float> px = posX, pz = posZ, fx = fwdX, fz = fwdZ;
+        SteeringArrays a = { px.data(), posY.data(), pz.data(), fx.data(), fz.data(), speed.data(),
+                             tx.data(), ty.data(), tz.data(), active.data(), arrived.data() };
+        if (batch) SteerBatch(a, n, 0.1f, 2.0f);
+        else SteerScalar(a, n, 0.1f, 2.0f);
+        out[0] = px; out[1] = pz; out[2] = fx; out[3] = fz;
+    };
+    std::vector<float> steerRef[4];
+    std::vector<unsigned char> arrivedRef(n);
+    steer(false, steerRef, arrivedRef);
+
+    KinematicsLevel best = GetBestKinematicsLevel();
+    for (int level = KINEMATICS_SCALAR; level <= best; level++) {
+        SetKinematicsLevel((KinematicsLevel)level);
+        std::vector<float> batch(n);
+        SpeedControlBatch(in, batch.data(), n, params);
+        for (size_t i = 0; i < n; i++) assert(fabs(batch[i] - reference[i]) < 1e-4f);
+
+        std::vector<float> steered[4];
+        std::vector<unsigned char> arrived(n);
+        steer(true, steered, arrived);
+        assert(arrived == arrivedRef);
+        for (int a = 0; a < 4; a++) {
+            for (size_t i = 0; i < n; i++) assert(fabs(steered[a][i] - steerRef[a][i]) < 1e-4f);
+        }
+    }
+    SetKinematicsLevel(best);
+    assert(GetKinematicsLevel() == best);
+}
+
+// --- TEST 21: Route planner (A*, trees, LRU cache, batch, route following) ---
+TEST_CASE(TestRoutePlanner) {
+    // 1 -> 2, then a short branch (4) and a long one (3); only the long one reaches exit 6
+    RoadGraph graph;
+    graph.AddNode(1, {0,0,0}, START);
+    graph.AddNode(2, {10,0,0}, DECISION);
+    graph.AddNode(3, {20,0,20}, ARC);
+    graph.AddNode(4, {20,0,2}, ARC);
+    graph.AddNode(5, {30,0,0}, TELEPORT);
+    graph.AddNode(6, {30,0,30}, TELEPORT);
+    graph.SetTeleportTarget(5, 1);
+    graph.SetTeleportTarget(6, 1);
+    graph.ConnectNodes(1, 2);
+    graph.ConnectNodes(2, 3);
+    graph.ConnectNodes(2, 4);
+    graph.ConnectNodes(3, 5);
+    graph.ConnectNodes(4, 5);
+    graph.ConnectNodes(3, 6);
+    graph.ConnectNodes(5, 1);   // Never part of a route: vehicles jump away from a teleport
+    graph.Finalize();
+    int n1 = graph.IndexOf(1), n2 = graph.IndexOf(2), n3 = graph.IndexOf(3), n4 = graph.IndexOf(4);
+    int n5 = graph.IndexOf(5), n6 = graph.IndexOf(6);
+
+    RoutePlanner planner;
+    planner.Build(graph);
+    std::vector<int> path;
+    float cost = 0.0f;
+    assert(planner.FindRoute(n1, n5, path, &cost));
+    assert((path == std::vector<int>{ n1, n2, n4, n5 }));
+    assert(!planner.FindRoute(n4, n6, path) && path.empty());
+
+    // Same answer from the shortest-path tree
+    ShortestPathTree tree;
+    planner.ComputeTree(n5, tree);
+    assert(fabs(tree.cost[n1] - cost) < 1e-3f && !tree.Reaches(n6));
+    tree.PathFrom(n1, path);
+    assert((path == std::vector<int>{ n1, n2, n4, n5 }));
+
+    // Costlier short branch: the route moves to the other one
+    std::vector<float> costs = planner.GetEdgeCosts();
+    costs[graph.FindEdge(n2, n4)] *= 10.0f;
+    planner.SetEdgeCosts(costs);
+    assert(planner.FindRoute(n1, n5, path) && path[2] == n3);
+    assert(planner.TreeTo(n5)->next[n2] == n3);
+
+    // LRU: capacity 1 keeps the last tree only
+    planner.ClearCache();
+    planner.SetCacheCapacity(1);
+    long long misses = planner.GetCacheMisses();
+    planner.TreeTo(n5);
+    planner.TreeTo(n6);
+    planner.TreeTo(n5);
+    assert(planner.GetCacheMisses() == misses + 3 && planner.GetCachedTreeCount() == 1);
+    planner.SetCacheCapacity(2);
+    planner.TreeTo(n6);
+    long long hits = planner.GetCacheHits();
+    planner.TreeTo(n5);
+    planner.TreeTo(n6);
+    assert(planner.GetCacheHits() == hits + 2 && planner.GetCachedTreeCount() == 2);
+
+    // Batch on several threads == one query at a time
+    std::vector<RouteRequest> requests;
+    for (int origin = 0; origin < graph.GetNodeCount(); origin++) {
+        requests.push_back({ origin, n5 });
+        requests.push_back({ origin, n6 });
+    }
+    std::vector<std::vector<int>> routes;
+    JobSystem jobs(3);
+    planner.ClearCache();
+    planner.PlanBatch(requests, routes, &jobs);
+    assert(routes.size() == requests.size());
+    for (size_t r = 0; r < requests.size(); r++) {
+        std::vector<int> single;
+        planner.TreeTo(requests[r].destination)->PathFrom(requests[r].origin, single);
+        assert(routes[r] == single);
+        if (graph.TypeOf(requests[r].origin) != TELEPORT) {
+            planner.FindRoute(requests[r].origin, requests[r].destination, single);
+            assert(routes[r] == single);
+        }
+    }
+
+    // A vehicle on a route takes the routed branch at the decision node
+    RouteTable table;
+    table.Clear(graph.GetNodeCount());
+    int routeId = table.Add(planner.TreeTo(n6));
+    uint32_t seed = 7;
+    assert(table.PickFrom(n1, seed) == routeId && table.PickFrom(n4, seed) == -1);
+    assert(table.NextNode(routeId, n2) == n3 && table.NextNode(routeId, n6) == -1);
+
+    VehicleState state;
+    state.position = graph.PositionOf(n2);
+    state.currentNodeId = 1;
+    state.targetNodeId = 2;
+    state.routeId = routeId;
+    VehiclePool vehicles;
+    vehicles.Create<Car>(state);
+    VehicleKinematics& k = vehicles.GetKinematics();
+    OccupancyIndex occupancy;
+    occupancy.Watch(graph);
+    occupancy.Update(vehicles);
+    bool onBranch = false;
+    for (int tick = 0; tick < 20; tick++) {
+        Vehicle::Move(k, 0, 0.1f, graph, occupancy, &table);
+        assert(k.targetNodeId[0] != 4);
+        if (k.targetNodeId[0] == 3) onBranch = true;
+    }
+    assert(onBranch);
+}
+
+// --- TEST 22: Contraction hierarchy (same costs as Dijkstra, valid paths, save / load) ---
+TEST_CASE(TestContractionHierarchy) {
+    // 10 x 10 grid with one-way and missing streets, a few teleports
+    const int size = 10;
+    SimRandom rng(2024);
+    RoadGraph graph;
+    for (int id = 0; id < size * size; id++) {
+        Vector3 pos = { (id % size) * 20.0f + rng.Range(-30, 30) / 10.0f, 0.0f, (id / size) * 20.0f };
+        graph.AddNode(id, pos, id % 17 == 5 ? TELEPORT : DECISION);
+    }
+    for (int id = 0; id < size * size; id++) {
+        int neighbours[2] = { id % size + 1 < size ? id + 1 : -1, id + size < size * size ? id + size : -1 };
+        for (int other : neighbours) {
+            if (other < 0) continue;
+            int roll = rng.Range(0, 9);   // 0-6 two-way, 7 / 8 one-way, 9 missing
+            if (roll <= 7) graph.ConnectNodes(id, other);
+            if (roll <= 6 || roll == 8) graph.ConnectNodes(other, id);
+        }
+    }
+    graph.Finalize();
+    RoutePlanner planner;
+    planner.Build(graph);
+    std::vector<float> costs = planner.GetEdgeCosts();
+    for (float& c : costs) c *= rng.Range(5, 20) / 10.0f;   // Not just lengths
+    planner.SetEdgeCosts(costs);
+
+    ContractionHierarchy ch;
+    ch.Build(graph, costs);
+    assert(ch.IsBuilt() && ch.GetNodeCount() == graph.GetNodeCount());
+
+    auto checkAll = [&](const ContractionHierarchy& hierarchy) {
+        ChQuery query(hierarchy);
+        int reachable = 0;
+        for (int destination = 0; destination < graph.GetNodeCount(); destination++) {
+            ShortestPathTree tree;
+            planner.ComputeTree(destination, tree);
+            for (int origin = 0; origin < graph.GetNodeCount(); origin++) {
+                float cost = -1.0f;
+                std::vector<int> path;
+                bool found = query.FindRoute(origin, destination, &cost, &path);
+                assert(found == tree.Reaches(origin));
+                if (!found) {
+                    assert(path.empty());
+                    continue;
+                }
+                reachable++;
+                assert(fabs(cost - tree.cost[origin]) < 1e-3f);
+                // A real path of the graph with that cost, through no teleport
+                assert(path.front() == origin && path.back() == destination);
+                float sum = 0.0f;
+                for (size_t k = 0; k + 1 < path.size(); k++) {
+                    int edge = graph.FindEdge(path[k], path[k + 1]);
+                    assert(edge >= 0 && (k == 0 || graph.TypeOf(path[k]) != TELEPORT));
+                    sum += costs[edge];
+                }
+                assert(fabs(sum - cost) < 1e-3f);
+            }
+        }
+        assert(reachable > graph.GetNodeCount() * graph.GetNodeCount() / 2);
+    };
+    checkAll(ch);
+
+    // Saved once, loaded back: same answers
+    std::stringstream file;
+    ch.Save(file);
+    ContractionHierarchy loaded;
+    loaded.Load(file, graph);
+    assert(loaded.GetEdgeCount() == ch.GetEdgeCount() && loaded.GetShortcutCount() == ch.GetShortcutCount());
+    checkAll(loaded);
+
+    // Another graph, or not a hierarchy at all
+    RoadGraph other;
+    other.AddNode(1, {0,0,0}, START);
+    other.Finalize();
+    bool thrown = false;
+    std::stringstream again;
+    ch.Save(again);
+    try { loaded.Load(again, other); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+    thrown = false;
+    std::stringstream garbage("not a hierarchy");
+    try { loaded.Load(garbage, graph); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown && loaded.GetNodeCount() == graph.GetNodeCount());
+}
+
+// --- TEST 23: Dynamic routing (tree repair, travel times, background refresher) ---
+TEST_CASE(TestDynamicRouting) {
+    // Same kind of grid as TEST 22: repairing a tree after cost changes == computing it again
+    const int size = 8;
+    SimRandom rng(77);
+    RoadGraph graph;
+    for (int id = 0; id < size * size; id++) {
+        graph.AddNode(id, { (id % size) * 20.0f, 0.0f, (id / size) * 20.0f + rng.Range(-20, 20) / 10.0f }, DECISION);
+    }
+    for (int id = 0; id < size * size; id++) {
+        if (id % size + 1 < size) { graph.ConnectNodes(id, id + 1); graph.ConnectNodes(id + 1, id); }
+        if (id + size < size * size && rng.Range(0, 3) > 0) { graph.ConnectNodes(id, id + size); graph.ConnectNodes(id + size, id); }
+    }
+    graph.Finalize();
+
+    RoutePlanner planner;
+    planner.Build(graph);
+    std::vector<int> destinations = { 0, 27, size * size - 1 };
+    std::vector<std::shared_ptr<ShortestPathTree>> trees;
+    planner.ComputeTrees(destinations, trees);
+    for (int round = 0; round < 5; round++) {
+        std::vector<float> costs = planner.GetEdgeCosts();
+        for (int n = 0; n < 10; n++) costs[rng.Range(0, graph.GetEdgeCount() - 1)] *= rng.Range(2, 80) / 10.0f;
+        costs[rng.Range(0, graph.GetEdgeCount() - 1)] *= 1.01f;   // Under the tolerance: ignored
+        std::vector<RoutePlanner::EdgeChange> changes = planner.UpdateEdgeCosts(costs, 0.05f);
+        assert(!changes.empty() && changes.size() <= 10);
+        for (size_t d = 0; d < destinations.size(); d++) {
+            planner.RepairTree(*trees[d], changes);
+            ShortestPathTree fresh;
+            planner.ComputeTree(destinations[d], fresh);
+            for (int node = 0; node < graph.GetNodeCount(); node++) {
+                assert(fabs(trees[d]->cost[node] - fresh.cost[node]) < 1e-3f * std::max(1.0f, fresh.cost[node]));
+                int next = trees[d]->next[node];
+                if (next >= 0) {   // Ties may pick another edge, never a costlier one
+                    float viaNext = planner.GetEdgeCosts()[graph.FindEdge(node, next)] + trees[d]->cost[next];
+                    assert(fabs(viaNext - fresh.cost[node]) < 1e-3f * std::max(1.0f, fresh.cost[node]));
+                }
+            }
+        }
+    }
+
+    // Travel times: free flow until observed, then a moving average
+    TravelTimes times;
+    times.Reset(graph, 10.0f);
+    int edge = graph.FindEdge(graph.IndexOf(0), graph.IndexOf(1));
+    float freeTime = Vector3Distance(graph.PositionOf(graph.IndexOf(0)), graph.PositionOf(graph.IndexOf(1))) / 10.0f;
+    assert(fabs(times.GetEstimates()[edge] - freeTime) < 1e-4f);
+    times.Observe(edge, 12.0f);
+    assert(fabs(times.GetEstimates()[edge] - (freeTime + (12.0f - freeTime) * TravelTimes::SMOOTHING)) < 1e-4f);
+    VehicleKinematics k;
+    VehicleState state;
+    state.doneEdge = edge;
+    state.doneTime = 12.0f;
+    k.PushBack(state);
+    times.Collect(k);
+    assert(times.GetObservationCount() == 2 && k.doneEdge[0] == -1);
+    // A vehicle stuck on an edge for longer than the estimate raises it in the snapshot
+    k.currentNodeId[0] = 1;
+    k.targetNodeId[0] = 2;
+    k.edgeTime[0] = 50.0f;
+    std::vector<float> snapshot;
+    times.Snapshot(k, graph, snapshot);
+    assert(snapshot[graph.FindEdge(graph.IndexOf(1), graph.IndexOf(2))] == 50.0f && snapshot[edge] == times.GetEstimates()[edge]);
+
+    // Refresher: a jam on the route gives a new table (same route IDs) with a detour
+    RouteRefresher router;
+    std::vector<float> freeFlow = times.GetFreeFlowTimes();
+    router.Start(graph, destinations, freeFlow);
+    std::shared_ptr<const RouteTable> before = router.GetRoutes();
+    int origin = size * size - 1;
+    int first = before->NextNode(0, origin);
+    std::vector<float> jammed = freeFlow;
+    jammed[graph.FindEdge(origin, first)] *= 100.0f;
+    router.Submit(freeFlow);   // Replaced before it runs, or found unchanged
+    router.Submit(jammed);
+    router.WaitIdle();
+    std::shared_ptr<const RouteTable> after = router.GetRoutes();
+    assert(after != before && after->GetRouteCount() == before->GetRouteCount());
+    assert(after->DestinationOf(0) == 0 && after->NextNode(0, origin) != first);
+    assert(before->NextNode(0, origin) == first);   // Tables already handed out never change
+    assert(router.GetRefreshCount() == 1 && router.GetRepairedNodeCount() > 0);
+    router.Submit(jammed);
+    router.WaitIdle();
+    assert(router.GetRoutes() == after && router.GetRefreshCount() == 1);
+    router.Stop();
+    assert(!router.IsRunning());
+
+    // Whole sim with rerouting: same run on 1 and 4 threads
+    SimulationConfig saved = globalConfig;
+    globalConfig = GetDefaultConfig();
+    globalConfig.rerouteInterval = 0.5f;
+    auto run = [](int threads) {
+        globalConfig.threadCount = threads;
+        SimulationCore sim;
+        sim.Init();
+        sim.ApplyConfiguration();
+        for (int t = 0; t < 1200; t++) sim.Step(1.0f / 60.0f);
+        assert(sim.GetTravelTimes().GetObservationCount() > 0);
+        return sim.GetStats();
+    };
+    SimulationStats one = run(1);
+    SimulationStats four = run(4);
+    assert(one.speedSum == four.speedSum && one.completed == four.completed && one.spawned == four.spawned);
+
+    // New simulation while a refresh may still be running (the app does not wait for the
+    // router): the graph is only rebuilt once the worker is stopped
+    globalConfig.threadCount = 1;
+    SimulationCore sim;
+    sim.SetRouteSync(false);
+    sim.Init();
+    sim.ApplyConfiguration();
+    int interval = (int)(globalConfig.rerouteInterval * globalConfig.tickRate + 0.5f);
+    for (int restart = 0; restart < 4; restart++) {
+        // Whole intervals until trees get repaired (traffic built up), then a few more: the
+        // last tick submits costs and nothing waits for the refresh. Not every submission
+        // changes a cost, hence a different count per restart.
+        do {
+            for (int t = 0; t < interval; t++) sim.Step(1.0f / 60.0f);
+        } while (sim.GetRouteRefresher().GetRefreshCount() < 2);
+        for (int t = 0; t < interval * (restart + 1); t++) sim.Step(1.0f / 60.0f);
+        sim.ApplyConfiguration();
+        assert(sim.GetRouteRefresher().IsRunning() && sim.GetVehicleCount() == 0);
+        assert(sim.GetRoadGraph().IsFinalized());
+    }
+    for (int t = 0; t < 300; t++) sim.Step(1.0f / 60.0f);
+    assert(sim.GetVehicleCount() > 0);
+    globalConfig = saved;
+}
+
+// --- TEST 24: Frustum culling (camera volume vs points, spheres, boxes) ---
+TEST_CASE(TestFrustumCulling) {
+    // Camera above the map looking at the origin, as CameraController places it
+    Camera3D camera = { 0 };
+    camera.position = { 0.0f, 50.0f, 50.0f };
+    camera.target = { 0.0f, 0.0f, 0.0f };
+    camera.up = { 0.0f, 1.0f, 0.0f };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    Frustum view = Frustum::FromCamera(camera, 16.0f / 9.0f);
+    assert(view.IsEnabled());
+
+    assert(view.ContainsPoint({ 0.0f, 0.0f, 0.0f }));        // Looked at
+    assert(view.ContainsPoint({ 30.0f, 0.0f, 0.0f }));       // Wider than high: still in on the side
+    assert(!view.ContainsPoint({ 0.0f, 50.0f, 80.0f }));     // Behind the camera
+    assert(!view.ContainsPoint({ 200.0f, 0.0f, 0.0f }));     // Far to the right
+    assert(!view.ContainsPoint({ 0.0f, 0.0f, -2000.0f }));   // Past the far plane
+
+    // Sphere / box across the right edge: kept; the same moved further out: culled
+    assert(!view.ContainsPoint({ 60.0f, 0.0f, 0.0f }));
+    assert(view.IntersectsSphere({ 60.0f, 0.0f, 0.0f }, 30.0f));
+    assert(!view.IntersectsSphere({ 200.0f, 0.0f, 0.0f }, 30.0f));
+    assert(view.IntersectsBox({ { 40.0f, 0.0f, -5.0f }, { 80.0f, 5.0f, 5.0f } }));
+    assert(!view.IntersectsBox({ { 150.0f, 0.0f, -5.0f }, { 190.0f, 5.0f, 5.0f } }));
+
+    // Box enclosing the map: kept from anywhere in it
+    assert(view.IntersectsBox({ { -150.0f, 0.0f, -150.0f }, { 150.0f, 10.0f, 150.0f } }));
+
+    // A box turned by 90 degrees and moved keeps enclosing its corners
+    BoundingBox box = { { -1.0f, 0.0f, -2.0f }, { 1.0f, 3.0f, 2.0f } };
+    Matrix transform = MatrixMultiply(MatrixRotateY(90.0f * DEG2RAD), MatrixTranslate(10.0f, 0.0f, 0.0f));
+    BoundingBox moved = TransformBox(box, transform);
+    assert(fabsf(moved.min.x - 8.0f) < 1e-4f && fabsf(moved.max.x - 12.0f) < 1e-4f);
+    assert(fabsf(moved.min.z + 1.0f) < 1e-4f && fabsf(moved.max.z - 1.0f) < 1e-4f);
+    assert(fabsf(moved.max.y - 3.0f) < 1e-4f);
+
+    // Default frustum: culling off
+    Frustum none;
+    assert(none.ContainsPoint({ 0.0f, 0.0f, -5000.0f }) && none.IntersectsSphere({ 1e6f, 0.0f, 0.0f }, 1.0f));
+}
+
+// --- TEST 25: Vehicle level of detail (hysteresis, mesh simplification) ---
+static void FreeMeshData(Mesh& mesh) {
+    RL_FREE(mesh.vertices);
+    RL_FREE(mesh.normals);
+    RL_FREE(mesh.texcoords);
+    RL_FREE(mesh.colors);
+    RL_FREE(mesh.indices);
+    mesh = Mesh();
+}
+
+TEST_CASE(TestVehicleLod) {
+    VehicleLodConfig config;   // 80 / 200, +- 8
+    assert(SelectVehicleLod(VEHICLE_LOD_FULL, 50.0f, config) == VEHICLE_LOD_FULL);
+    assert(SelectVehicleLod(VEHICLE_LOD_FULL, 300.0f, config) == VEHICLE_LOD_BOX);      // Straight to the box
+    assert(SelectVehicleLod(VEHICLE_LOD_BOX, 20.0f, config) == VEHICLE_LOD_FULL);       // And back
+
+    // Around the first boundary the level only changes past the margin
+    assert(SelectVehicleLod(VEHICLE_LOD_FULL, 85.0f, config) == VEHICLE_LOD_FULL);
+    assert(SelectVehicleLod(VEHICLE_LOD_FULL, 90.0f, config) == VEHICLE_LOD_REDUCED);
+    assert(SelectVehicleLod(VEHICLE_LOD_REDUCED, 75.0f, config) == VEHICLE_LOD_REDUCED);
+    assert(SelectVehicleLod(VEHICLE_LOD_REDUCED, 70.0f, config) == VEHICLE_LOD_FULL);
+    // Same at the box boundary
+    assert(SelectVehicleLod(VEHICLE_LOD_REDUCED, 205.0f, config) == VEHICLE_LOD_REDUCED);
+    assert(SelectVehicleLod(VEHICLE_LOD_BOX, 195.0f, config) == VEHICLE_LOD_BOX);
+    assert(SelectVehicleLod(VEHICLE_LOD_BOX, 190.0f, config) == VEHICLE_LOD_REDUCED);
+
+    // A 10 x 10 m sheet of 32 x 32 quads, slightly bent
+    const int N = 32;
+    Mesh sheet = {};
+    sheet.vertexCount = (N + 1) * (N + 1);
+    sheet.triangleCount = N * N * 2;
+    sheet.vertices = (float*)RL_CALLOC(sheet.vertexCount * 3, sizeof(float));
+    sheet.normals = (float*)RL_CALLOC(sheet.vertexCount * 3, sizeof(float));
+    sheet.indices = (unsigned short*)RL_CALLOC(sheet.triangleCount * 3, sizeof(unsigned short));
+    for (int z = 0; z <= N; z++) {
+        for (int x = 0; x <= N; x++) {
+            int v = z * (N + 1) + x;
+            sheet.vertices[v * 3 + 0] = 10.0f * x / N;
+            sheet.vertices[v * 3 + 1] = 0.5f * sinf(x * 0.2f);
+            sheet.vertices[v * 3 + 2] = 10.0f * z / N;
+            sheet.normals[v * 3 + 1] = 1.0f;
+        }
+    }
+    int i = 0;
+    for (int z = 0; z < N; z++) {
+        for (int x = 0; x < N; x++) {
+            unsigned short a = (unsigned short)(z * (N + 1) + x), b = a + 1, c = a + N + 1, d = c + 1;
+            unsigned short quad[6] = { a, c, b, b, c, d };
+            for (unsigned short q : quad) sheet.indices[i++] = q;
+        }
+    }
+
+    Mesh reduced = SimplifyMesh(sheet, 1.0f);
+    assert(reduced.triangleCount > 0 && reduced.triangleCount * 8 < sheet.triangleCount);
+    assert(reduced.vertexCount < sheet.vertexCount && reduced.normals && !reduced.texcoords);
+    for (int t = 0; t < reduced.triangleCount * 3; t++) assert(reduced.indices[t] < reduced.vertexCount);
+    for (int v = 0; v < reduced.vertexCount; v++) {
+        // Averages of the original vertices: inside the sheet
+        assert(reduced.vertices[v * 3] >= 0.0f && reduced.vertices[v * 3] <= 10.0f);
+        assert(fabsf(reduced.vertices[v * 3 + 1]) <= 0.5f);
+        assert(fabsf(reduced.normals[v * 3 + 1] - 1.0f) < 1e-5f);
+    }
+    FreeMeshData(reduced);
+
+    // Cells finer than the quads keep every triangle; one cell for everything keeps none
+    Mesh same = SimplifyMesh(sheet, 0.05f);
+    assert(same.triangleCount == sheet.triangleCount);
+    FreeMeshData(same);
+    Mesh none = SimplifyMesh(sheet, 100.0f);
+    assert(none.triangleCount == 0 && none.vertices == nullptr);
+    FreeMeshData(sheet);
 }
 
 int main() {
-    // Raylib requires a window context for some functions (like GetFrameTime) 
-    // used in TrafficManager, so we init a headless/tiny window if needed.
-    InitWindow(100, 100, "Unit Tests");
-    SetTargetFPS(60);
+    // Only the headless core is linked: no window / GL context needed
 
     // need this commit to test:
     // & "C:\raylib\w64devkit\bin\mingw32-make.exe" test
@@ -97,9 +1222,27 @@ int main() {
     RUN_TEST(TestVehicleInitialization);
     RUN_TEST(TestVehicleSpawner);
     RUN_TEST(TestTeleportationLogic);
+    RUN_TEST(TestSpatialGridQuery);
+    RUN_TEST(TestRoadGraphFinalize);
+    RUN_TEST(TestEventScheduler);
+    RUN_TEST(TestOccupancyIndex);
+    RUN_TEST(TestSpawnerQueues);
+    RUN_TEST(TestVehiclePool);
+    RUN_TEST(TestVehicleTypeGroups);
+    RUN_TEST(TestVehicleTypeRegistry);
+    RUN_TEST(TestScenarioParsing);
+    RUN_TEST(TestHeadlessSimulation);
+    RUN_TEST(TestFixedTimestep);
+    RUN_TEST(TestTurboPacing);
+    RUN_TEST(TestParallelUpdate);
+    RUN_TEST(TestJobSystem);
+    RUN_TEST(TestKinematicsKernel);
+    RUN_TEST(TestRoutePlanner);
+    RUN_TEST(TestContractionHierarchy);
+    RUN_TEST(TestDynamicRouting);
+    RUN_TEST(TestFrustumCulling);
+    RUN_TEST(TestVehicleLod);
 
     std::cout << "--- ALL TESTS PASSED ---\n";
-    
-    CloseWindow();
     return 0;
 }
\ No newline at end of file
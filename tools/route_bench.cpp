@@ -0,0 +1,219 @@
+// Routing benchmark on a generated city grid: contraction hierarchy vs plain Dijkstra (and A*).
+//
+//   route_bench [--size N] [--queries N] [--seed N] [--save FILE] [--load FILE]
+//
+// The grid has N x N intersections (default 500: 250 000 nodes), 50 m blocks, one-way and
+// missing streets, faster avenues every 8 blocks and expressways every 64; the edge cost is
+// the travel time.
+// --save writes the hierarchy after the build, --load reads it instead of building it
+// (the file must come from the same --size / --seed).
+// Every query is checked against Dijkstra: the exit code is 1 if a cost differs.
+
+#include "contraction_hierarchy.h"
+#include "route_planner.h"
+#include "sim_random.h"
+#include "raymath.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+
+static const float BLOCK_SIZE = 50.0f;
+
+static void PrintUsage(const char* program) {
+    std::printf("usage: %s [--size N] [--queries N] [--seed N] [--save FILE] [--load FILE]\n", program);
+}
+
+static double Seconds(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+// N x N intersections; costs[e] = travel time (s) of dense edge e
+static void BuildCityGrid(int size, uint32_t seed, RoadGraph& graph, std::vector<float>& costs) {
+    SimRandom rng(seed);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            Vector3 pos = { x * BLOCK_SIZE + rng.Range(-80, 80) / 10.0f, 0.0f, y * BLOCK_SIZE + rng.Range(-80, 80) / 10.0f };
+            graph.AddNode(y * size + x, pos, DECISION);
+        }
+    }
+    // Each street: two-way (80 %), one-way either direction (15 %), missing (5 %)
+    auto street = [&](int a, int b) {
+        int roll = rng.Range(0, 99);
+        if (roll < 80) { graph.ConnectNodes(a, b); graph.ConnectNodes(b, a); }
+        else if (roll < 87) graph.ConnectNodes(a, b);
+        else if (roll < 95) graph.ConnectNodes(b, a);
+    };
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            if (x + 1 < size) street(y * size + x, y * size + x + 1);
+            if (y + 1 < size) street(y * size + x, (y + 1) * size + x);
+        }
+    }
+    graph.Finalize();
+
+    // 50 km/h streets, 70 km/h avenues every 8 blocks, 110 km/h expressways every 64
+    costs.assign(graph.GetEdgeCount(), 0.0f);
+    auto lineSpeed = [](int line) { return line % 64 == 0 ? 30.6f : line % 8 == 0 ? 19.4f : 13.9f; };
+    for (int from = 0; from < graph.GetNodeCount(); from++) {
+        int e = graph.FirstEdge(from);
+        for (int to : graph.Successors(from)) {
+            int a = graph.IdOf(from), b = graph.IdOf(to);
+            float speed = a / size == b / size ? lineSpeed(a / size) : lineSpeed(a % size);
+            costs[e++] = Vector3Distance(graph.PositionOf(from), graph.PositionOf(to)) / speed;
+        }
+    }
+}
+
+// Plain Dijkstra, stopped as soon as the destination is settled
+class Dijkstra {
+private:
+    typedef std::pair<float, int> QueueEntry;
+    const RoadGraph& graph;
+    const std::vector<float>& costs;
+    std::vector<float> cost;
+    std::vector<uint32_t> stamp;
+    uint32_t current = 0;
+
+public:
+    int settled = 0;
+
+    Dijkstra(const RoadGraph& g, const std::vector<float>& c)
+        : graph(g), costs(c), cost(g.GetNodeCount()), stamp(g.GetNodeCount(), 0) {}
+
+    float Run(int origin, int destination) {
+        current++;
+        settled = 0;
+        auto costOf = [&](int node) { return stamp[node] == current ? cost[node] : ROUTE_UNREACHABLE; };
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+        cost[origin] = 0.0f;
+        stamp[origin] = current;
+        open.push({ 0.0f, origin });
+        while (!open.empty()) {
+            QueueEntry top = open.top();
+            open.pop();
+            int node = top.second;
+            if (top.first > costOf(node)) continue;
+            settled++;
+            if (node == destination) return top.first;
+            int e = graph.FirstEdge(node);
+            for (int to : graph.Successors(node)) {
+                float c = top.first + costs[e++];
+                if (c < costOf(to)) {
+                    cost[to] = c;
+                    stamp[to] = current;
+                    open.push({ c, to });
+                }
+            }
+        }
+        return ROUTE_UNREACHABLE;
+    }
+};
+
+int main(int argc, char** argv) {
+    int size = 500;
+    int queries = 1000;
+    uint32_t seed = 12345;
+    std::string savePath, loadPath;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--size") == 0 && hasValue) size = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--queries") == 0 && hasValue) queries = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--save") == 0 && hasValue) savePath = argv[++i];
+        else if (std::strcmp(argv[i], "--load") == 0 && hasValue) loadPath = argv[++i];
+        else { PrintUsage(argv[0]); return 2; }
+    }
+    if (size < 2 || queries <= 0) { PrintUsage(argv[0]); return 2; }
+
+    RoadGraph graph;
+    std::vector<float> costs;
+    auto start = std::chrono::steady_clock::now();
+    BuildCityGrid(size, seed, graph, costs);
+    std::printf("graph             : %d nodes, %d edges (generated in %.2f s)\n", graph.GetNodeCount(), graph.GetEdgeCount(), Seconds(start));
+
+    ContractionHierarchy ch;
+    try {
+        if (!loadPath.empty()) {
+            start = std::chrono::steady_clock::now();
+            std::ifstream in(loadPath, std::ios::binary);
+            if (!in) throw std::runtime_error("cannot open " + loadPath);
+            ch.Load(in, graph);
+            std::printf("hierarchy         : loaded from %s in %.3f s\n", loadPath.c_str(), Seconds(start));
+        }
+        else {
+            start = std::chrono::steady_clock::now();
+            ch.Build(graph, costs);
+            std::printf("hierarchy         : built in %.2f s, %zu shortcuts\n", Seconds(start), ch.GetShortcutCount());
+        }
+        if (!savePath.empty()) {
+            start = std::chrono::steady_clock::now();
+            std::ofstream out(savePath, std::ios::binary);
+            ch.Save(out);
+            if (!out) throw std::runtime_error("cannot write " + savePath);
+            std::printf("saved             : %s in %.3f s\n", savePath.c_str(), Seconds(start));
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+
+    // Same random pairs for every method
+    SimRandom rng(seed ^ 0x9E3779B9u);
+    std::vector<RouteRequest> pairs(queries);
+    for (RouteRequest& r : pairs) {
+        r.origin = rng.Range(0, graph.GetNodeCount() - 1);
+        r.destination = rng.Range(0, graph.GetNodeCount() - 1);
+    }
+
+    Dijkstra dijkstra(graph, costs);
+    std::vector<float> reference(queries);
+    long long dijkstraSettled = 0;
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        reference[q] = dijkstra.Run(pairs[q].origin, pairs[q].destination);
+        dijkstraSettled += dijkstra.settled;
+    }
+    double dijkstraTime = Seconds(start);
+
+    RoutePlanner planner;
+    planner.Build(graph);
+    planner.SetEdgeCosts(costs);
+    std::vector<int> path;
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) planner.FindRoute(pairs[q].origin, pairs[q].destination, path);
+    double astarTime = Seconds(start);
+
+    ChQuery query(ch);
+    int mismatches = 0;
+    long long chSettled = 0;
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        float cost = ROUTE_UNREACHABLE;
+        query.FindRoute(pairs[q].origin, pairs[q].destination, &cost);
+        chSettled += query.GetSettledCount();
+        if (std::fabs(cost - reference[q]) > 1e-3f * std::max(1.0f, reference[q])) mismatches++;
+    }
+    double chTime = Seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) query.FindRoute(pairs[q].origin, pairs[q].destination, nullptr, &path);
+    double chPathTime = Seconds(start);
+
+    auto perQuery = [&](double seconds) { return seconds / queries * 1e6; };
+    std::printf("queries           : %d random pairs\n", queries);
+    std::printf("dijkstra          : %10.1f us/query, %lld nodes settled/query\n", perQuery(dijkstraTime), dijkstraSettled / queries);
+    std::printf("a*                : %10.1f us/query (full path)\n", perQuery(astarTime));
+    std::printf("ch (cost)         : %10.1f us/query, %lld nodes settled/query (%.0fx dijkstra)\n", perQuery(chTime),
+                chSettled / queries, dijkstraTime / (chTime > 0.0 ? chTime : 1e-9));
+    std::printf("ch (full path)    : %10.1f us/query\n", perQuery(chPathTime));
+    std::printf("mismatches        : %d\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+// Headless batch runner: steps the simulation as fast as the CPU allows, no window needed.
+//
+//   sim_runner [scenario.txt] [--ticks N] [--dt SECONDS] [--seed N] [--threads N] [--random-turns] [--profile]
+//
+// Without a scenario file the default configuration (same demand as the app) is used.
+// The tick length defaults to 1 / tick_rate of the scenario (60 Hz), like the app.
+// --threads 0 uses one thread per core; the results are the same for any thread count.
+// --random-turns turns routing off: vehicles pick a random branch at every decision node.
+// --profile prints the time spent in each task of the tick graph and how long each thread sat idle.
+
+#include "simulation_core.h"
+#include "scenario.h"
+#include "config.h"
+#include "kinematics_kernel.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+static void PrintUsage(const char* program) {
+    std::printf("usage: %s [scenario.txt] [--ticks N] [--dt SECONDS] [--seed N] [--threads N] [--random-turns] [--profile]\n", program);
+}
+
+int main(int argc, char** argv) {
+    std::string scenarioPath;
+    long long ticks = 36000;     // 10 minutes of sim time at 60 Hz
+    float dt = 0.0f;             // 0 = from the config tick rate
+    bool seedGiven = false;
+    unsigned int seed = 0;
+    int threads = -1;            // -1 = from the scenario
+    bool profile = false;
+    bool randomTurns = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--ticks") == 0 && hasValue) ticks = std::atoll(argv[++i]);
+        else if (std::strcmp(argv[i], "--dt") == 0 && hasValue) dt = (float)std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) { seed = (unsigned int)std::strtoul(argv[++i], nullptr, 10); seedGiven = true; }
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--random-turns") == 0) randomTurns = true;
+        else if (std::strcmp(argv[i], "--profile") == 0) profile = true;
+        else if (argv[i][0] != '-' && scenarioPath.empty()) scenarioPath = argv[i];
+        else { PrintUsage(argv[0]); return 2; }
+    }
+    if (ticks <= 0 || dt < 0.0f) { PrintUsage(argv[0]); return 2; }
+
+    try {
+        globalConfig = GetDefaultConfig();
+        if (!scenarioPath.empty()) globalConfig = LoadScenario(scenarioPath, globalConfig);
+        if (seedGiven) globalConfig.seed = seed;
+        if (dt > 0.0f) globalConfig.tickRate = 1.0f / dt;
+        if (threads >= 0) globalConfig.threadCount = threads;
+        if (randomTurns) globalConfig.routing = false;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+
+    SimulationCore sim;
+    sim.Init();
+    sim.ApplyConfiguration();
+
+    dt = sim.GetTickDt();
+    sim.GetJobs().SetProfiling(profile);
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long t = 0; t < ticks; t++) sim.Step(dt);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (wall <= 0.0) wall = 1e-9;
+
+    const SimulationStats& s = sim.GetStats();
+    std::printf("scenario          : %s (seed %u)\n", scenarioPath.empty() ? "<default>" : scenarioPath.c_str(), globalConfig.seed);
+    std::printf("threads           : %d (%s kinematics)\n", sim.GetThreadCount(), GetKinematicsLevelName(GetKinematicsLevel()));
+    std::printf("routes            : %d planned in %.2f ms (before the first tick)\n", sim.GetRoutes().GetRouteCount(),
+                sim.GetRoutePlanningTime() * 1000.0);
+    const RouteRefresher& router = sim.GetRouteRefresher();
+    std::printf("route refreshes   : %lld every %.1f s (%lld nodes repaired, last in %.2f ms, %lld travel times observed)\n",
+                router.GetRefreshCount(), globalConfig.rerouteInterval, router.GetRepairedNodeCount(),
+                router.GetLastRefreshTime() * 1000.0, sim.GetTravelTimes().GetObservationCount());
+    std::printf("ticks             : %lld x %.4f s = %.1f s sim time\n", s.ticks, dt, s.simTime);
+    std::printf("wall time         : %.3f s (%.1f sim-s / wall-s)\n", wall, s.simTime / wall);
+    std::printf("throughput        : %.0f ticks/s, %.0f vehicle-updates/s\n", s.ticks / wall, s.vehicleUpdates / wall);
+    std::printf("vehicles          : %d spawned, %d completed, %d active, %d still queued (peak %d)\n",
+                s.spawned, s.completed, sim.GetVehicleCount(), sim.GetQueuedCount(), s.peakVehicles);
+    std::printf("average speed     : %.2f m/s\n", s.AverageSpeed());
+    std::printf("stopped           : %.1f %% of vehicle-updates\n", s.StoppedRatio() * 100.0);
+    for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+        const VehicleTypeStats& ts = s.byType[t];
+        if (ts.spawned == 0) continue;
+        std::printf("  %-15s : %d spawned, %d completed, %.2f m/s average\n", GetVehicleTypeName((VehicleType)t),
+                    ts.spawned, ts.completed, ts.AverageSpeed());
+    }
+
+    if (profile) {
+        const JobSystem& jobs = sim.GetJobs();
+        double runTime = jobs.GetRunTime() > 0.0 ? jobs.GetRunTime() : 1e-9;
+        std::printf("\n%-16s %12s %12s %10s\n", "task", "total ms", "us / tick", "chunks");
+        for (const TaskProfile& p : jobs.GetProfile()) {
+            std::printf("%-16s %12.1f %12.2f %10lld\n", p.name.c_str(), p.busyTime * 1000.0,
+                        p.runs ? p.busyTime * 1e6 / p.runs : 0.0, p.chunks);
+        }
+        const std::vector<double>& busy = jobs.GetThreadBusyTime();
+        for (size_t t = 0; t < busy.size(); t++) {
+            std::printf("thread %-2d         : %.1f %% busy, %.1f %% idle\n", (int)t,
+                        busy[t] / runTime * 100.0, (1.0 - busy[t] / runTime) * 100.0);
+        }
+    }
+    return 0;
+}